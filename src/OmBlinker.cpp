@@ -5,7 +5,11 @@
  */
 
 #include "OmBlinker.h"
+#if NOT_ARDUINO
+#include "OmHostWiFi.h"
+#else
 #include "Arduino.h"
+#endif
 
 OmBlinker::OmBlinker(int ledPin)
 {
@@ -26,6 +26,12 @@ public:
         UNUSED(ch);
         return false; // not supported by this streamer
     }
+    bool putN(const uint8_t *data, size_t size) override
+    {
+        UNUSED(data);
+        UNUSED(size);
+        return false; // not supported by this streamer
+    }
 
     int width;
     int height;
@@ -107,15 +113,18 @@ public:
         this->x++;
         if(this->x == this->width || (this->x & 0x0007) == 0) // finished one byte in progress
         {
-            this->consumer->put(this->byteInProgress);
+            this->rowBytes[this->rowBytesIndex++] = this->byteInProgress;
             this->byteInProgress = 0;
+            if(this->rowBytesIndex >= kRowBytesRun)
+                result &= this->flushRowBytes();
         }
 
         if(this->x == this->width)
         {
             // at the end of the row, do our special dance
             for(int ix = 0; ix < this->rowPadBytes; ix++)
-                result &= this->put8(0);
+                this->rowBytes[this->rowBytesIndex++] = 0;
+            result &= this->flushRowBytes();
             this->x = 0;
             this->y++;
         }
@@ -124,27 +133,36 @@ public:
 
 
 private:
-    bool putN(int n, uint8_t *data)
+    // pixels are gathered here and passed on a run at a time, at least every row.
+    static const unsigned int kRowBytesRun = 32;
+    uint8_t rowBytes[kRowBytesRun + 3]; // and room for the row padding
+    unsigned int rowBytesIndex = 0;
+
+    bool flushRowBytes()
     {
-        bool result = true;
-        while(n-- > 0)
-            result &= this->consumer->put(*data++);
+        bool result = this->consumer->putN(this->rowBytes, this->rowBytesIndex);
+        this->rowBytesIndex = 0;
         return result;
     }
 
+    bool putBytes(int n, uint8_t *data)
+    {
+        return this->consumer->putN(data, n);
+    }
+
     bool put8(uint8_t x)
     {
-        return this->putN(1, &x);
+        return this->putBytes(1, &x);
     }
 
     bool put16(uint16_t x)
     {
-        return this->putN(2, (uint8_t *)&x);
+        return this->putBytes(2, (uint8_t *)&x);
     }
 
     bool put32(uint32_t x)
     {
-        return this->putN(4, (uint8_t *)&x);
+        return this->putBytes(4, (uint8_t *)&x);
     }
 
 };
@@ -176,6 +194,12 @@ public:
         UNUSED(ch);
         return false; // not supported by this streamer
     }
+    bool putN(const uint8_t *data, size_t size) override
+    {
+        UNUSED(data);
+        UNUSED(size);
+        return false; // not supported by this streamer
+    }
 
     bool putBmpHeader()
     {
@@ -227,18 +251,17 @@ public:
             result &= this->putBmpHeader();
             this->didPutHeader = true;
         }
-        result &= this->put8(b);
-        result &= this->put8(g);
-        result &= this->put8(r);
+        uint8_t bgr[3] = {b, g, r};
+        result &= this->putBytes(3, bgr);
 
         this->x++;
         if(this->x >= this->width)
         {
             // Each row must be padded to a multiple of four BYTES.
             // since each pixel is 3 bytes, this can happen.
+            uint8_t zeros[3] = {0, 0, 0};
             int extras = (4 - (this->width * 3) % 4) % 4;
-            while(extras-- > 0)
-                this->put8(0);
+            this->putBytes(extras, zeros);
 
             this->x = 0;
             this->y++;
@@ -254,27 +277,24 @@ public:
     }
 
 private:
-    bool putN(int n, uint8_t *data)
+    bool putBytes(int n, uint8_t *data)
     {
-        bool result = true;
-        while(n-- > 0)
-            result &= this->consumer->put(*data++);
-        return result;
+        return this->consumer->putN(data, n);
     }
 
     bool put8(uint8_t x)
     {
-        return this->putN(1, &x);
+        return this->putBytes(1, &x);
     }
 
     bool put16(uint16_t x)
     {
-        return this->putN(2, (uint8_t *)&x);
+        return this->putBytes(2, (uint8_t *)&x);
     }
 
     bool put32(uint32_t x)
     {
-        return this->putN(4, (uint8_t *)&x);
+        return this->putBytes(4, (uint8_t *)&x);
     }
 
 };
@@ -310,15 +330,50 @@ public:
         if(this->bufSize == 3)
         {
             // when we get three chars, emit four.
-            result &= this->consumer->put(base64_table[this->buf[0] >> 2]);
-            result &= this->consumer->put(base64_table[((this->buf[0] & 0x03) << 4) | (this->buf[1] >> 4)]);
-            result &= this->consumer->put(base64_table[((this->buf[1] & 0x0f) << 2) | (this->buf[2] >> 6)]);
-            result &= this->consumer->put(base64_table[this->buf[2] & 0x3f]);
+            uint8_t out[4];
+            encode3(this->buf, out);
+            result &= this->consumer->putN(out, 4);
             bufSize = 0;
         }
         return result;
     }
 
+    bool putN(const uint8_t *data, size_t size) override
+    {
+        if(this->isDone)
+            return false;
+
+        bool result = true;
+        // top up any partial triple first
+        while(this->bufSize && size)
+        {
+            result &= this->put(*data++);
+            size--;
+        }
+
+        // then whole triples, encoded a block at a time
+        uint8_t out[64];
+        size_t outSize = 0;
+        while(size >= 3)
+        {
+            encode3(data, out + outSize);
+            outSize += 4;
+            data += 3;
+            size -= 3;
+            if(outSize == sizeof(out))
+            {
+                result &= this->consumer->putN(out, outSize);
+                outSize = 0;
+            }
+        }
+        result &= this->consumer->putN(out, outSize);
+
+        // and hold onto the last byte or two
+        while(size--)
+            this->buf[this->bufSize++] = *data++;
+        return result;
+    }
+
     bool done() override
     {
         bool result = true;
@@ -346,6 +401,15 @@ public:
         this->bufSize = 0;
         return result;
     }
+
+private:
+    static void encode3(const uint8_t *in, uint8_t *out)
+    {
+        out[0] = base64_table[in[0] >> 2];
+        out[1] = base64_table[((in[0] & 0x03) << 4) | (in[1] >> 4)];
+        out[2] = base64_table[((in[1] & 0x0f) << 2) | (in[2] >> 6)];
+        out[3] = base64_table[in[2] & 0x3f];
+    }
 };
 
 #endif // __OmBmp__
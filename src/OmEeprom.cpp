@@ -1,6 +1,7 @@
 #include "OmEeprom.h"
 #include "OmUtil.h"
 #include "OmLog.h"
+#include <string.h>
 
 #ifdef NOT_ARDUINO
 #include "EepromTesting.h"
@@ -294,6 +295,7 @@ bool OmEepromClass::put(const char *fieldName, const void *value, int valueLengt
     int copyLength = field->length;
     if(valueLength >= 0 && valueLength < copyLength)
         copyLength = valueLength;
+    uint32_t wasHash = omHashBytes(this->data + field->offset, field->length);
     
     memcpy(this->data + field->offset, value, copyLength);
     if(copyLength < field->length)
@@ -333,6 +335,9 @@ bool OmEepromClass::put(const char *fieldName, const void *value, int valueLengt
         while(wx < field->offset + field->length)
               this->data[wx++] = 0;
     }
+
+    if(omHashBytes(this->data + field->offset, field->length) != wasHash)
+        field->changeSerial = omChangeSerialNext();
     
     return true;
 }
@@ -546,13 +551,17 @@ bool OmEepromClass::set(const char *fieldName, int first, int count, uint8_t *by
     OmEepromField *f = this->findField(fieldName);
     if(f && f->type == OME_TYPE_BYTES)
     {
+        bool changed = false;
         while(count--)
         {
             if(first < 0 || first >= f->length)
                 break;
+            changed |= this->data[f->offset + first] != *bytes;
             this->data[f->offset + first] = *bytes++;
             first++;
         }
+        if(changed)
+            f->changeSerial = omChangeSerialNext();
         return true;
     }
     return false; // no such field
@@ -615,6 +624,13 @@ int OmEepromClass::getFieldType(int ix)
     return this->fields[ix].type;
 }
 
+uint32_t OmEepromClass::getFieldChangeSerial(int ix)
+{
+    if(ix < 0 || ix >= (int)this->fields.size())
+        return 0;
+    return this->fields[ix].changeSerial;
+}
+
 void OmEepromClass::setString(const char *fieldName, String value)
 {
     OmEepromField *f = this->findField(fieldName);
@@ -45,6 +45,7 @@ public:
     const char *description = 0;
 
     int offset = 0;
+    uint32_t changeSerial = 0; // omChangeSerialNext() of its last change, for "_status?since="
 };
 
 /*! @brief Wrapper for eeprom, lets you structure fields and check signature */
@@ -98,6 +99,8 @@ public:
     const char *getFieldName(int ix);
     int getFieldLength(int ix);
     int getFieldType(int ix);
+    /// The change serial of the field's last change, or 0 if it hasn't since begin().
+    uint32_t getFieldChangeSerial(int ix);
 
     OmEepromField *findField(const char *fieldName);
     OmEepromField *findField(int ix);
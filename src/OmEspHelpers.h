@@ -14,6 +14,7 @@
 #include "OmWebPages.h"
 #include "OmWebRequest.h"
 #include "OmXmlWriter.h"
+#include "OmJsonWriter.h"
 #include "OmNtp.h"
 #include "OmBmp.h"
 #include "OmEeprom.h"
@@ -0,0 +1,200 @@
+/*
+ * OmHostWiFi.cpp
+ *
+ * Implementation of OmHostWiFi, the desktop stand-in for the ESP WiFi
+ * classes, on POSIX sockets.
+ */
+
+#if NOT_ARDUINO
+
+#include "OmHostWiFi.h"
+
+#include <chrono>
+#include <thread>
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0 // (mac) SO_NOSIGPIPE is set on the socket instead
+#endif
+
+OmHostWiFiClass WiFi;
+OmHostMDNSClass MDNS;
+OmHostESPClass ESP;
+
+unsigned long millis()
+{
+    static auto start = std::chrono::steady_clock::now();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+}
+
+void delay(unsigned long ms)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void OmHostESPClass::restart()
+{
+    printf("ESP.restart() on host: exiting\n");
+    exit(0);
+}
+
+/// The file descriptor, closed when the last WiFiClient copy lets go.
+class OmHostSocket
+{
+public:
+    int fd;
+    OmHostSocket(int fd) : fd(fd) {}
+    ~OmHostSocket() { this->close(); }
+    void close()
+    {
+        if(this->fd >= 0)
+            ::close(this->fd);
+        this->fd = -1;
+    }
+};
+
+WiFiClient::WiFiClient(int fd)
+{
+    this->socket = std::make_shared<OmHostSocket>(fd);
+}
+
+bool WiFiClient::connected()
+{
+    if(!this->socket || this->socket->fd < 0)
+        return false;
+    // like the ESP: still "connected" while there are unread bytes, even if the peer closed.
+    uint8_t b;
+    ssize_t k = recv(this->socket->fd, &b, 1, MSG_PEEK | MSG_DONTWAIT);
+    if(k > 0)
+        return true;
+    if(k == 0)
+        return false;
+    return errno == EAGAIN || errno == EWOULDBLOCK;
+}
+
+int WiFiClient::available()
+{
+    if(!this->socket || this->socket->fd < 0)
+        return 0;
+    int k = 0;
+    if(ioctl(this->socket->fd, FIONREAD, &k) < 0)
+        return 0;
+    return k;
+}
+
+int WiFiClient::read(uint8_t *buffer, size_t size)
+{
+    if(!this->socket || this->socket->fd < 0)
+        return -1;
+    return (int)recv(this->socket->fd, buffer, size, MSG_DONTWAIT);
+}
+
+size_t WiFiClient::write(const uint8_t *data, size_t size)
+{
+    if(!this->socket || this->socket->fd < 0)
+        return 0;
+    size_t sent = 0;
+    while(sent < size)
+    {
+        ssize_t k = send(this->socket->fd, data + sent, size - sent, MSG_NOSIGNAL);
+        if(k <= 0)
+            break;
+        sent += k;
+    }
+    return sent;
+}
+
+void WiFiClient::stop()
+{
+    if(this->socket)
+        this->socket->close();
+    this->socket.reset();
+}
+
+void WiFiClient::setNoDelay(bool noDelay)
+{
+    if(!this->socket || this->socket->fd < 0)
+        return;
+    int flag = noDelay ? 1 : 0;
+    setsockopt(this->socket->fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+}
+
+IPAddress WiFiClient::remoteIP()
+{
+    sockaddr_in addr = {};
+    socklen_t len = sizeof(addr);
+    if(!this->socket || getpeername(this->socket->fd, (sockaddr *)&addr, &len) < 0)
+        return IPAddress();
+    return IPAddress((uint32_t)addr.sin_addr.s_addr); // already network order, which is what IPAddress keeps
+}
+
+uint16_t WiFiClient::remotePort()
+{
+    sockaddr_in addr = {};
+    socklen_t len = sizeof(addr);
+    if(!this->socket || getpeername(this->socket->fd, (sockaddr *)&addr, &len) < 0)
+        return 0;
+    return ntohs(addr.sin_port);
+}
+
+WiFiServer::~WiFiServer()
+{
+    if(this->fd >= 0)
+        close(this->fd);
+}
+
+void WiFiServer::begin()
+{
+    if(this->fd >= 0)
+        return;
+    this->fd = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(this->fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(this->port);
+    if(bind(this->fd, (sockaddr *)&addr, sizeof(addr)) < 0 || listen(this->fd, 128) < 0)
+    {
+        perror("WiFiServer::begin");
+        close(this->fd);
+        this->fd = -1;
+        return;
+    }
+    fcntl(this->fd, F_SETFL, fcntl(this->fd, F_GETFL) | O_NONBLOCK);
+}
+
+WiFiClient WiFiServer::available()
+{
+    if(this->fd < 0)
+        return WiFiClient();
+    int clientFd = accept(this->fd, NULL, NULL);
+    if(clientFd < 0)
+        return WiFiClient();
+#ifdef SO_NOSIGPIPE
+    int one = 1;
+    setsockopt(clientFd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+    return WiFiClient(clientFd);
+}
+
+bool WiFiServer::hasClient()
+{
+    if(this->fd < 0)
+        return false;
+    pollfd pfd = {this->fd, POLLIN, 0};
+    return poll(&pfd, 1, 0) > 0;
+}
+
+#endif // NOT_ARDUINO
@@ -0,0 +1,155 @@
+/*
+ * OmHostWiFi.h
+ *
+ * Just enough of the Arduino and ESP WiFi api for OmWebServer to build and
+ * run on a desktop (NOT_ARDUINO), over ordinary sockets on the loopback
+ * interface. The wifi is always "connected", and the LED, bonjour and
+ * captive DNS do nothing. It's for measuring and testing the server, not
+ * for serving anything real.
+ *
+ * EXAMPLE
+ *
+ *   OmWebServer s(8080);
+ *   s.addWifi("host", ""); // any name, it just needs one
+ *   s.setHandler(pages);
+ *   while(1) s.tick();
+ *
+ * See tools/omWebBench for a load generator built this way.
+ */
+
+#ifndef __OmHostWiFi__
+#define __OmHostWiFi__
+
+#if NOT_ARDUINO
+
+#include <stdint.h>
+#include <stddef.h>
+#include <memory>
+#include <string>
+
+#ifndef String
+#define String std::string
+#endif
+
+unsigned long millis();
+void delay(unsigned long ms);
+
+#define OUTPUT 1
+#define HIGH 1
+#define LOW 0
+inline void pinMode(int pin, int mode) { (void)pin; (void)mode; }
+inline void digitalWrite(int pin, int value) { (void)pin; (void)value; }
+
+/// Four bytes in network order, converting to and from uint32_t the way the ESP libraries do.
+class IPAddress
+{
+public:
+    uint8_t bytes[4] = {0, 0, 0, 0};
+
+    IPAddress() {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) { bytes[0] = a; bytes[1] = b; bytes[2] = c; bytes[3] = d; }
+    IPAddress(uint32_t ip) { for(int ix = 0; ix < 4; ix++) bytes[ix] = (uint8_t)(ip >> (8 * ix)); }
+    operator uint32_t() const { return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((uint32_t)bytes[3] << 24); }
+    uint8_t &operator[](int ix) { return bytes[ix]; }
+    uint8_t operator[](int ix) const { return bytes[ix]; }
+};
+
+typedef enum
+{
+    WL_NO_SHIELD = 255,
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_SCAN_COMPLETED = 2,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_DISCONNECTED = 6
+} wl_status_t;
+
+typedef enum
+{
+    WIFI_OFF = 0,
+    WIFI_STA = 1,
+    WIFI_AP = 2,
+} WiFiMode_t;
+
+class OmHostSocket;
+
+/// One tcp connection. Copies share the socket, as with the ESP WiFiClient.
+class WiFiClient
+{
+public:
+    WiFiClient() {}
+    WiFiClient(int fd);
+
+    bool connected();
+    int available();
+    int read(uint8_t *buffer, size_t size);
+    size_t write(const uint8_t *data, size_t size);
+    void stop();
+    void setNoDelay(bool noDelay);
+    IPAddress remoteIP();
+    uint16_t remotePort();
+    operator bool() const { return (bool)this->socket; }
+
+private:
+    std::shared_ptr<OmHostSocket> socket;
+};
+
+/// Listens on 127.0.0.1:port.
+class WiFiServer
+{
+public:
+    WiFiServer(int port) : port(port) {}
+    ~WiFiServer();
+    void begin();
+    WiFiClient available(); // a newly accepted client, or an empty one
+    bool hasClient(); // a connection is waiting to be accepted
+private:
+    int port;
+    int fd = -1;
+};
+
+/// The wifi is always up, on loopback.
+class OmHostWiFiClass
+{
+public:
+    int status() { return WL_CONNECTED; }
+    void begin(const char *ssid, const char *password) { (void)ssid; (void)password; }
+    void disconnect() {}
+    void persistent(bool persistent) { (void)persistent; }
+    void mode(int mode) { (void)mode; }
+    void hostname(const char *name) { (void)name; }
+    void setHostname(const char *name) { (void)name; }
+    bool softAP(const char *ssid, const char *password) { (void)ssid; (void)password; return true; }
+    IPAddress localIP() { return IPAddress(127, 0, 0, 1); }
+    IPAddress softAPIP() { return IPAddress(127, 0, 0, 1); }
+};
+extern OmHostWiFiClass WiFi;
+
+class OmHostMDNSClass
+{
+public:
+    bool begin(const char *name) { (void)name; return true; }
+    void addService(const char *service, const char *protocol, int port) { (void)service; (void)protocol; (void)port; }
+    void update() {}
+};
+extern OmHostMDNSClass MDNS;
+
+class DNSServer
+{
+public:
+    bool start(int port, const char *domain, IPAddress ip) { (void)port; (void)domain; (void)ip; return true; }
+    void processNextRequest() {}
+};
+
+class OmHostESPClass
+{
+public:
+    void restart();
+};
+extern OmHostESPClass ESP;
+
+#endif // NOT_ARDUINO
+
+#endif // __OmHostWiFi__
@@ -0,0 +1,221 @@
+/*
+ * OmJsonWriter.cpp
+ *
+ * Implementation of OmJsonWriter.
+ */
+
+#include "OmJsonWriter.h"
+#include "OmPrintfStream.h"
+#include <stdio.h>
+#include <string.h>
+
+OmJsonWriter::OmJsonWriter(OmIByteStream *consumer)
+{
+    this->consumer = consumer;
+    this->isArray[0] = false;
+    this->hasAnything[0] = false;
+}
+
+bool OmJsonWriter::putRaw(const char *s)
+{
+    size_t len = strlen(s);
+    this->byteCount += len;
+    return this->consumer->putN((const uint8_t *)s, len);
+}
+
+/// Quotes, backslashes and control characters get escaped; runs between them go in one go.
+bool OmJsonWriter::putEscaped(const uint8_t *data, size_t size)
+{
+    bool ok = true;
+    const uint8_t *run = data;
+    const uint8_t *end = data + size;
+    while(data < end)
+    {
+        uint8_t ch = *data;
+        if(ch == '"' || ch == '\\' || ch < 0x20)
+        {
+            this->byteCount += data - run;
+            ok &= this->consumer->putN(run, data - run);
+            char escape[8];
+            switch(ch)
+            {
+                case '"': strcpy(escape, "\\\""); break;
+                case '\\': strcpy(escape, "\\\\"); break;
+                case '\n': strcpy(escape, "\\n"); break;
+                case '\r': strcpy(escape, "\\r"); break;
+                case '\t': strcpy(escape, "\\t"); break;
+                default: sprintf(escape, "\\u%04x", ch); break;
+            }
+            ok &= this->putRaw(escape);
+            run = data + 1;
+        }
+        data++;
+    }
+    this->byteCount += data - run;
+    ok &= this->consumer->putN(run, data - run);
+    return ok;
+}
+
+/// The comma and key before any value, checked against what it's in.
+void OmJsonWriter::beginValue(const char *key)
+{
+    if(this->inString)
+    {
+        this->errorCount++;
+        this->endString();
+    }
+    if(this->hasAnything[this->depth])
+        this->putRaw(",");
+    this->hasAnything[this->depth] = true;
+
+    bool wantsKey = this->depth > 0 && !this->isArray[this->depth];
+    if(wantsKey != (key != NULL))
+        this->errorCount++;
+    if(wantsKey && key)
+    {
+        this->putRaw("\"");
+        this->putEscaped((const uint8_t *)key, strlen(key));
+        this->putRaw("\":");
+    }
+}
+
+void OmJsonWriter::begin(const char *key, bool isArray)
+{
+    this->beginValue(key);
+    if(this->depth >= kOmJsonMaxDepth)
+    {
+        this->errorCount++;
+        return;
+    }
+    this->putRaw(isArray ? "[" : "{");
+    this->depth++;
+    this->isArray[this->depth] = isArray;
+    this->hasAnything[this->depth] = false;
+}
+
+void OmJsonWriter::end(bool isArray)
+{
+    if(this->inString)
+        this->endString();
+    if(this->depth <= 0 || this->isArray[this->depth] != isArray)
+    {
+        this->errorCount++;
+        return;
+    }
+    this->putRaw(isArray ? "]" : "}");
+    this->depth--;
+}
+
+void OmJsonWriter::beginObject(const char *key)
+{
+    this->begin(key, false);
+}
+
+void OmJsonWriter::endObject()
+{
+    this->end(false);
+}
+
+void OmJsonWriter::beginArray(const char *key)
+{
+    this->begin(key, true);
+}
+
+void OmJsonWriter::endArray()
+{
+    this->end(true);
+}
+
+void OmJsonWriter::endAll()
+{
+    if(this->inString)
+        this->endString();
+    while(this->depth > 0)
+        this->end(this->isArray[this->depth]);
+}
+
+void OmJsonWriter::addString(const char *key, const char *value)
+{
+    if(!value)
+    {
+        this->addNull(key);
+        return;
+    }
+    this->beginString(key);
+    this->putS(value); // through our putN(), escaped, and from flash if need be
+    this->endString();
+}
+
+void OmJsonWriter::addStringF(const char *key, const char *fmt, ...)
+{
+    va_list v;
+    va_start(v, fmt);
+    this->beginString(key);
+    OmPrintfStream::putVF(this, fmt, v); // through our put(), escaped
+    this->endString();
+    va_end(v);
+}
+
+void OmJsonWriter::addInt(const char *key, long long int value)
+{
+    this->beginValue(key);
+    char s[24];
+    sprintf(s, "%lld", value);
+    this->putRaw(s);
+}
+
+void OmJsonWriter::addBool(const char *key, bool value)
+{
+    this->beginValue(key);
+    this->putRaw(value ? "true" : "false");
+}
+
+void OmJsonWriter::addNull(const char *key)
+{
+    this->beginValue(key);
+    this->putRaw("null");
+}
+
+void OmJsonWriter::beginString(const char *key)
+{
+    this->beginValue(key);
+    this->putRaw("\"");
+    this->inString = true;
+}
+
+void OmJsonWriter::endString()
+{
+    if(this->inString)
+    {
+        this->inString = false;
+        this->putRaw("\"");
+    }
+}
+
+int OmJsonWriter::getErrorCount()
+{
+    return this->errorCount;
+}
+
+unsigned int OmJsonWriter::getByteCount()
+{
+    return this->byteCount;
+}
+
+bool OmJsonWriter::put(uint8_t ch)
+{
+    return this->putN(&ch, 1);
+}
+
+bool OmJsonWriter::putN(const uint8_t *data, size_t size)
+{
+    if(this->inString)
+        return this->putEscaped(data, size);
+    this->byteCount += size;
+    return this->consumer->putN(data, size);
+}
+
+bool OmJsonWriter::done()
+{
+    return this->consumer->done();
+}
@@ -0,0 +1,100 @@
+/*
+ * OmJsonWriter.h
+ *
+ * The JSON sibling of OmXmlWriter. It writes to an OmIByteStream as it
+ * goes, with no buffer for the document, keeping only a fixed-depth stack
+ * of which objects and arrays are open, to get the commas right.
+ *
+ * Inside an object, every value needs a key; inside an array, pass NULL.
+ *
+ * EXAMPLE
+ *
+ * OmJsonWriter j(&someStream);
+ * j.beginObject();
+ * j.addString("name", "lamp");
+ * j.addInt("value", 7);
+ * j.beginArray("pins");
+ * j.addInt(NULL, 4);
+ * j.addInt(NULL, 5);
+ * j.endArray();
+ * j.endObject();
+ *
+ * To produce {"name":"lamp","value":7,"pins":[4,5]}
+ */
+
+#ifndef __OmJsonWriter__
+#define __OmJsonWriter__
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "OmXmlWriter.h" // for OmIByteStream
+
+/*!
+ @class OmJsonWriter
+ Writes JSON to an OmIByteStream, streaming as it goes
+ */
+class OmJsonWriter : public OmIByteStream
+{
+public:
+    static const int kOmJsonMaxDepth = 20;
+    OmIByteStream *consumer = 0;
+    int depth = 0;
+    bool isArray[kOmJsonMaxDepth + 1];
+    bool hasAnything[kOmJsonMaxDepth + 1];
+    bool inString = false; // between beginString() and endString(), put() escapes
+    int errorCount = 0;
+    unsigned int byteCount = 0;
+
+    /*! @brief Instantiate a JSON writer to write to the consumer */
+    OmJsonWriter(OmIByteStream *consumer);
+
+    /*! @brief Begins an object, like "key":{ */
+    void beginObject(const char *key = NULL);
+    /*! @brief Ends the most recent beginObject() */
+    void endObject();
+
+    /*! @brief Begins an array, like "key":[ */
+    void beginArray(const char *key = NULL);
+    /*! @brief Ends the most recent beginArray() */
+    void endArray();
+
+    /*! @brief Ends any remaining objects and arrays. */
+    void endAll();
+
+    /*! @brief Adds a string value, escaped, like "key":"value" */
+    void addString(const char *key, const char *value);
+    /*! @brief Adds a string value, using printf semantics */
+    void addStringF(const char *key, const char *fmt, ...);
+    /*! @brief Adds a number */
+    void addInt(const char *key, long long int value);
+    /*! @brief Adds true or false */
+    void addBool(const char *key, bool value);
+    /*! @brief Adds null */
+    void addNull(const char *key);
+
+    /*! @brief Begins a string value to stream into with put(), escaped as it goes. */
+    void beginString(const char *key);
+    /*! @brief Ends the string value */
+    void endString();
+
+    /*! @brief Returns nonzero of any errors occurred, like a missing key or too deep. */
+    int getErrorCount();
+
+    /*! @brief Bytes written. */
+    unsigned int getByteCount();
+
+    /*! Our own put. Inside beginString() it's escaped, otherwise it goes straight through. */
+    bool put(uint8_t ch) override;
+    bool putN(const uint8_t *data, size_t size) override;
+    bool done() override;
+
+private:
+    void beginValue(const char *key);
+    void begin(const char *key, bool isArray);
+    void end(bool isArray);
+    bool putRaw(const char *s);
+    bool putEscaped(const uint8_t *data, size_t size);
+};
+
+#endif /* defined(__OmJsonWriter__) */
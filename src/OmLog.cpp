@@ -10,12 +10,7 @@
 #include <stdio.h>
 #include <string.h>
 
-#if NOT_ARDUINO
-static long millis()
-{
-    return 0;
-}
-#else
+#ifndef NOT_ARDUINO
 //#define printf Serial.printf
 #endif
 
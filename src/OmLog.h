@@ -30,7 +30,7 @@
 #include <WiFi.h>
 #endif
 #if NOT_ARDUINO
-typedef unsigned char IPAddress[4];
+#include "OmHostWiFi.h"
 #endif
 
 #include <stdarg.h>
@@ -173,6 +173,14 @@ public:
     /*! client is public field so you can use it for URL queries too. */
     WiFiClient client; // shared, for sending requests
 };
+#else
+/*! On host builds there's no network time; this is just enough for OmWebServer::setNtp(). */
+class OmNtp
+{
+public:
+    void setWifiAvailable(bool wifiAvailable) { (void)wifiAvailable; }
+    void tick(unsigned int deltaMillis) { (void)deltaMillis; }
+};
 #endif //NOT_ARDUINO
 
 #endif // __OmNtp__
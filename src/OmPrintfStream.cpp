@@ -44,10 +44,7 @@ bool OmPrintfStream::handlePercent(const char *start, const char *end, VA_LIST_A
             // just a %s? we can put all the chars ourself.
             // no possible buffer overflow that way.
             const char *chP = va_arg(v, const char *);
-            while(*chP)
-            {
-                result &= this->consumer->put(*chP++);
-            }
+            result &= this->consumer->putS(chP);
             goto goHome;
         }
 
@@ -82,9 +79,7 @@ wrote = snprintf(output, littleBufferSize, format, x); \
                 result = false;
             }
             // but emit it anyway.
-            w = output;
-            while(*w)
-                this->consumer->put(*w++);
+            this->consumer->putS(output);
         }
     }
 goHome:
@@ -96,6 +91,16 @@ OmPrintfStream::OmPrintfStream(OmIByteStream *consumer)
     this->consumer = consumer;
 }
 
+bool OmPrintfStream::put(uint8_t ch)
+{
+    return this->consumer->put(ch);
+}
+
+bool OmPrintfStream::putN(const uint8_t *data, size_t size)
+{
+    return this->consumer->putN(data, size);
+}
+
 bool OmPrintfStream::putF(const char *fmt, ...)
 {
     va_list v;
@@ -115,6 +120,16 @@ bool OmPrintfStream::putVF(const char *fmt, VA_LIST_ARG)
     const char *percentBegin = 0;
     while(going)
     {
+        if(!inPercent)
+        {
+            // pass along the plain text up to the next % all at once.
+            const char *run = w;
+            while(*w && *w != '%')
+                w++;
+            if(w > run)
+                result &= this->consumer->putN((const uint8_t *)run, w - run);
+        }
+
         char ch = *w++;
         if(ch == 0)
         {
@@ -29,6 +29,11 @@ public:
 
     bool handlePercent(const char *start, const char *end, VA_LIST_ARG);
     OmPrintfStream(OmIByteStream *consumer);
+
+    /*! @brief bytes put directly pass straight through to the consumer */
+    bool put(uint8_t ch) override;
+    bool putN(const uint8_t *data, size_t size) override;
+
     bool putF(const char *fmt, ...);
     bool putVF(const char *fmt, VA_LIST_ARG);
 
@@ -7,10 +7,44 @@
 //
 
 #include "OmUtil.h"
+#include <stdarg.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
 #include <string.h>
 #include <string>
 #include <vector>
+#include <algorithm>
+
+#ifdef NOT_ARDUINO
+#include <time.h>
+#else
+#include "Arduino.h"
+#endif
+
+/// a char of s, in RAM or flash
+static inline char omCharAt(const char *s)
+{
+    return omIsFlash(s) ? (char)pgm_read_byte(s) : *s;
+}
+
+const char *omRam(const char *s)
+{
+    if(!omIsFlash(s))
+        return s;
+    static char ram[100];
+    size_t len = strlen_P(s);
+    if(len > sizeof(ram) - 1)
+        len = sizeof(ram) - 1;
+    memcpy_P(ram, s, len);
+    ram[len] = 0;
+    return ram;
+}
+
+size_t omStrlen(const char *s)
+{
+    return omIsFlash(s) ? strlen_P(s) : strlen(s);
+}
 
 bool omStringEqual(const char *s1, const char *s2, int maxLen)
 {
@@ -19,8 +53,8 @@ bool omStringEqual(const char *s1, const char *s2, int maxLen)
 
     while(maxLen-- > 0)
     {
-        char c1 = *s1++;
-        char c2 = *s2++;
+        char c1 = omCharAt(s1++);
+        char c2 = omCharAt(s2++);
         if(c1 != c2)
         {
             return false;
@@ -412,3 +446,188 @@ std::string ssprintf(const char *fmt, ...)
     std::string s = ssnprintf(fmt, v);
     return s;
 }
+
+uint32_t omHashString(const char *s)
+{
+    uint32_t hash = 2166136261u;
+    while(char c = omCharAt(s++))
+    {
+        hash ^= (uint8_t)c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+uint32_t omHashBytes(const void *data, size_t size)
+{
+    const uint8_t *d = (const uint8_t *)data;
+    uint32_t hash = 2166136261u;
+    while(size-- > 0)
+    {
+        hash ^= *d++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+uint32_t omTicks()
+{
+#ifdef NOT_ARDUINO
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint32_t)t.tv_sec * 1000000000u + (uint32_t)t.tv_nsec;
+#else
+    return ESP.getCycleCount();
+#endif
+}
+
+uint32_t omTicksToMicros(uint32_t ticks)
+{
+#ifdef NOT_ARDUINO
+    return ticks / 1000;
+#else
+    return ticks / ESP.getCpuFreqMHz();
+#endif
+}
+
+static uint32_t omChangeSerialCount = 0;
+
+uint32_t omChangeSerial()
+{
+    return omChangeSerialCount;
+}
+
+uint32_t omChangeSerialNext()
+{
+    return ++omChangeSerialCount;
+}
+
+void OmNameIndex::add(const char *name, void *value)
+{
+    if(!name)
+        return;
+    if((this->count + 1) * 2 > (int)this->slots.size())
+        this->grow();
+
+    uint32_t hash = omHashString(name);
+    size_t mask = this->slots.size() - 1;
+    size_t ix = hash & mask;
+    while(this->slots[ix].name)
+    {
+        if(this->slots[ix].hash == hash && omStringEqual(this->slots[ix].name, name, INT_MAX))
+            return; // first one stays
+        ix = (ix + 1) & mask;
+    }
+    this->slots[ix].hash = hash;
+    this->slots[ix].name = name;
+    this->slots[ix].value = value;
+    this->count++;
+}
+
+void *OmNameIndex::find(const char *name)
+{
+    if(!name || this->count == 0)
+        return NULL;
+    uint32_t hash = omHashString(name);
+    size_t mask = this->slots.size() - 1;
+    size_t ix = hash & mask;
+    while(this->slots[ix].name)
+    {
+        if(this->slots[ix].hash == hash && omStringEqual(this->slots[ix].name, name, INT_MAX))
+            return this->slots[ix].value;
+        ix = (ix + 1) & mask;
+    }
+    return NULL;
+}
+
+void OmNameIndex::clear()
+{
+    // keep the table, so a page rebuilt with the same names doesn't go back to the heap.
+    std::fill(this->slots.begin(), this->slots.end(), Slot{0, NULL, NULL});
+    this->count = 0;
+}
+
+void OmNameIndex::grow()
+{
+    std::vector<Slot> old;
+    old.swap(this->slots);
+    this->slots.resize(old.size() ? old.size() * 2 : 8, Slot{0, NULL, NULL});
+    this->count = 0;
+    for(Slot &slot : old)
+        if(slot.name)
+            this->add(slot.name, slot.value);
+}
+
+OmArena::OmArena(int blockSize)
+{
+    this->blockSize = blockSize;
+}
+
+OmArena::~OmArena()
+{
+    Block *block = this->blocks;
+    while(block)
+    {
+        Block *next = block->next;
+        free(block);
+        block = next;
+    }
+}
+
+void *OmArena::alloc(size_t size)
+{
+    size = (size + 7) & ~(size_t)7;
+    const size_t headerSize = (sizeof(Block) + 7) & ~(size_t)7;
+
+    // after a reset(), the blocks are reused in order; any too small for this are passed over
+    Block *block = this->current;
+    Block *last = NULL;
+    while(block && block->used + size > block->size)
+    {
+        last = block;
+        block = block->next;
+    }
+    if(!block)
+    {
+        size_t blockSize = size > (size_t)this->blockSize ? size : this->blockSize;
+        block = (Block *)malloc(headerSize + blockSize);
+        if(!block)
+            return NULL;
+        block->next = NULL;
+        block->size = blockSize;
+        block->used = 0;
+        if(last)
+            last->next = block;
+        else
+            this->blocks = block;
+        this->reserved += headerSize + blockSize;
+        this->blockCount++;
+    }
+    this->current = block;
+
+    void *result = (uint8_t *)block + headerSize + block->used;
+    block->used += size;
+    this->used += size;
+    if(this->used > this->highWater)
+        this->highWater = this->used;
+    return result;
+}
+
+const char *OmArena::copyString(const char *s)
+{
+    if(!s)
+        return NULL;
+    size_t size = strlen(s) + 1;
+    char *result = (char *)this->alloc(size);
+    if(result)
+        memcpy(result, s, size);
+    return result;
+}
+
+void OmArena::reset()
+{
+    for(Block *block = this->blocks; block; block = block->next)
+        block->used = 0;
+    this->current = this->blocks;
+    this->used = 0;
+}
@@ -11,6 +11,45 @@
 
 #include <string>
 #include <vector>
+#include <stdint.h>
+
+#ifdef NOT_ARDUINO
+// the flash string calls, so they compile and do the obvious thing off the ESPs.
+class __FlashStringHelper;
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+#define PSTR(s) (s)
+#define F(s) ((const __FlashStringHelper *)(s))
+#define FPSTR(s) ((const __FlashStringHelper *)(s))
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+#define memcpy_P memcpy
+#define strlen_P strlen
+#define strcmp_P strcmp
+#else
+#include <pgmspace.h>
+#endif
+
+/*! @brief true if p is in flash, like a PROGMEM array, F("...") or PSTR("..."), on the ESP8266.
+ There, flash can only be read a word at a time, with memcpy_P() and friends, so names and
+ labels that might be in flash are streamed through OmIByteStream::putS(), which checks this.
+ Elsewhere flash reads like RAM, and it's always false.
+ */
+inline bool omIsFlash(const void *p)
+{
+#ifdef ARDUINO_ARCH_ESP8266
+    return (uintptr_t)p >= 0x40200000; // where the flash is mapped
+#else
+    (void)p;
+    return false;
+#endif
+}
+
+/*! @brief s, or if it's in flash, a copy of it in a shared static char[] for printf
+ and such, which can't read flash. Use or copy soon. */
+const char *omRam(const char *s);
+/*! @brief strlen, in RAM or flash */
+size_t omStrlen(const char *s);
 
 bool omStringEqual(const char *s1, const char *s2, int maxLen = 100);
 /*! @brief Represent a number of milliseconds as a duration string, good for "uptime" displays. 1d2h3m4s like.
@@ -43,4 +82,82 @@ std::string ssprintf(const char *fmt, ...);
 
 
 
+/*! @brief FNV-1a hash of a zero-terminated string, in RAM or flash. */
+uint32_t omHashString(const char *s);
+/*! @brief FNV-1a hash of some bytes. */
+uint32_t omHashBytes(const void *data, size_t size);
+
+/*! @brief A cheap free-running timestamp for timing short things, like one request: the CPU
+ cycle counter on the ESPs, nanoseconds elsewhere. It wraps, so only differences mean anything. */
+uint32_t omTicks();
+/*! @brief A difference of omTicks(), in microseconds */
+uint32_t omTicksToMicros(uint32_t ticks);
+
+/*! @brief One count shared by everything that reports its changes, like item values and
+ eeprom fields. Each change stamps itself with omChangeSerialNext(), so a poller can ask
+ for whatever has a stamp above the omChangeSerial() it saw last time. */
+uint32_t omChangeSerial();
+/*! @brief count a change, and return its stamp */
+uint32_t omChangeSerialNext();
+
+/*! @brief A small string-to-pointer hash table, for finding things by name without a linear scan.
+ The names are not copied, so they must outlive the index, as string constants do. They can be in flash.
+ Adding a name that's already there keeps the first, the same as a front-to-back search would find.
+ */
+class OmNameIndex
+{
+public:
+    void add(const char *name, void *value);
+    void *find(const char *name);
+    void clear();
+    int size() { return this->count; }
+private:
+    typedef struct
+    {
+        uint32_t hash;
+        const char *name; // NULL for an empty slot
+        void *value;
+    } Slot;
+    std::vector<Slot> slots; // open addressing, power-of-two size, at most half full
+    int count = 0;
+    void grow();
+};
+
+#ifndef OM_ARENA_BLOCK_BYTES
+#define OM_ARENA_BLOCK_BYTES 256 // each block the arena takes from the heap; bigger requests get a block of their own
+#endif
+
+/*! @brief A bump allocator. alloc() hands out pieces of a few heap blocks, and reset()
+ takes them all back at once, keeping the blocks for next time. Something rebuilt over
+ and over, like a page, reuses the same memory instead of churning the heap.
+ Nothing is destructed; the owner calls destructors itself before reset().
+ */
+class OmArena
+{
+public:
+    OmArena(int blockSize = OM_ARENA_BLOCK_BYTES);
+    ~OmArena();
+    /*! @brief size bytes, 8-byte aligned, good until reset(). NULL if the heap is out. */
+    void *alloc(size_t size);
+    /*! @brief a copy of the string, in the arena. NULL stays NULL. */
+    const char *copyString(const char *s);
+    /*! @brief everything allocated is given back, all at once */
+    void reset();
+
+    size_t used = 0; // bytes handed out since the last reset()
+    size_t highWater = 0; // the most ever in use
+    size_t reserved = 0; // bytes taken from the heap for blocks
+    int blockCount = 0;
+private:
+    typedef struct Block
+    {
+        struct Block *next;
+        size_t size; // bytes after the header
+        size_t used;
+    } Block;
+    Block *blocks = NULL;
+    Block *current = NULL; // the block being bumped; the ones before it are full
+    int blockSize;
+};
+
 #endif /* defined(__OmUtil__) */
@@ -8,9 +8,14 @@
 #include "OmWebPages.h"
 #include "OmLog.h"
 #include "OmEeprom.h"
+#include "OmPrintfStream.h"
+#include "OmJsonWriter.h"
+#include "OmWebPagesAssets.h"
+#include <new> // placement new, for things in arenas
 
 #ifdef NOT_ARDUINO
 #include "EepromTesting.h"
+#include <time.h>
 #endif
 
 #ifndef NOT_ARDUINO
@@ -36,6 +41,184 @@
 
 OmWebPages OmWebPagesSingleton;
 
+static int omItemNamesSerial = 0; // bumped on every item rename, so pages know to reindex
+
+/// "_status", as XML or JSON. It's records of named values, and lists of records.
+/// In XML a record is an element and its values are attributes, and the records
+/// of a list just follow one another. In JSON they're objects and arrays.
+class StatusWriter
+{
+public:
+    virtual ~StatusWriter() {}
+    virtual void beginRecord(const char *name) = 0;
+    virtual void endRecord() = 0;
+    virtual void beginList(const char *name) = 0;
+    virtual void endList() = 0;
+    virtual void add(const char *name, const char *value) = 0;
+    virtual void add(const char *name, long long int value) = 0;
+    virtual void addF(const char *name, const char *fmt, ...) = 0;
+    /// a string value to stream into, with putF()
+    virtual void beginValue(const char *name) = 0;
+    virtual void putF(const char *fmt, ...) = 0;
+    virtual void endValue() = 0;
+};
+
+class XmlStatusWriter : public StatusWriter
+{
+public:
+    OmXmlWriter &w;
+    XmlStatusWriter(OmXmlWriter &w) : w(w) {}
+
+    void beginRecord(const char *name) override { this->w.beginElement(name); }
+    void endRecord() override { this->w.endElement(); }
+    void beginList(const char *name) override {}
+    void endList() override {}
+    void add(const char *name, const char *value) override { this->w.addAttribute(name, value); }
+    void add(const char *name, long long int value) override { this->w.addAttribute(name, value); }
+    void addF(const char *name, const char *fmt, ...) override
+    {
+        char value[160];
+        va_list v;
+        va_start(v, fmt);
+        vsnprintf(value, sizeof(value), fmt, v);
+        va_end(v);
+        this->w.addAttribute(name, value);
+    }
+    void beginValue(const char *name) override { this->w.beginAttribute(name); }
+    void putF(const char *fmt, ...) override
+    {
+        va_list v;
+        va_start(v, fmt);
+        OmPrintfStream::putVF(&this->w, fmt, v);
+        va_end(v);
+    }
+    void endValue() override { this->w.endAttribute(); }
+};
+
+class JsonStatusWriter : public StatusWriter
+{
+public:
+    OmJsonWriter j;
+    JsonStatusWriter(OmIByteStream *consumer) : j(consumer) {}
+
+    /// records in a list, and the outermost one, have no key
+    const char *keyFor(const char *name) { return this->j.depth && !this->j.isArray[this->j.depth] ? name : NULL; }
+
+    void beginRecord(const char *name) override { this->j.beginObject(this->keyFor(name)); }
+    void endRecord() override { this->j.endObject(); }
+    void beginList(const char *name) override { this->j.beginArray(this->keyFor(name)); }
+    void endList() override { this->j.endArray(); }
+    void add(const char *name, const char *value) override { this->j.addString(name, value); }
+    void add(const char *name, long long int value) override { this->j.addInt(name, value); }
+    void addF(const char *name, const char *fmt, ...) override
+    {
+        va_list v;
+        va_start(v, fmt);
+        this->j.beginString(name);
+        OmPrintfStream::putVF(&this->j, fmt, v);
+        this->j.endString();
+        va_end(v);
+    }
+    void beginValue(const char *name) override { this->j.beginString(name); }
+    void putF(const char *fmt, ...) override
+    {
+        va_list v;
+        va_start(v, fmt);
+        OmPrintfStream::putVF(&this->j, fmt, v);
+        va_end(v);
+    }
+    void endValue() override { this->j.endString(); }
+};
+
+/// The places in a page's markup that change with item values, spliced in at each render.
+typedef enum
+{
+    PH_FORMAT = 0, // the value through a printf format, like "%d"
+    PH_TIME, // the value as minutes of the day, "HH:MM"
+    PH_ATTRIBUTE_IF_EQUAL, // attribute="attribute" if the value is arg
+    PH_ATTRIBUTE_IF_BITS, // attribute="attribute" if the value has any of arg's bits
+    PH_SELECT_EXTRA, // a select's "(value)" option, when the value isn't one of its choices
+    PH_VALUE_SERIAL, // the body's data-values
+} EPageHoleKind;
+
+class PageHole
+{
+public:
+    uint32_t at = 0; // offset into the template's bytes
+    PageItem *item = NULL; // whose value
+    EPageHoleKind kind = PH_FORMAT;
+    const char *text = NULL; // the format, or the attribute name
+    int arg = 0;
+};
+
+/// A page rendered once with its values left out: markup, and where the values go.
+class PageTemplate
+{
+public:
+    uint8_t *bytes = NULL;
+    int size = 0;
+    int minifiedBytes = 0; // line breaks left out, for greatestRenderLengthUnminified
+    std::vector<PageHole> holes;
+
+    ~PageTemplate()
+    {
+        free(this->bytes);
+    }
+
+    int memorySize()
+    {
+        return this->size + (int)(this->holes.size() * sizeof(PageHole)) + (int)sizeof(PageTemplate);
+    }
+};
+
+// While a page is being compiled to a template, the items put this byte where their
+// value would go, and add a hole to the template saying how to fill it in.
+#define PAGE_HOLE_MARK "\x01"
+static PageTemplate *omCompilingTemplate = NULL;
+
+static bool addPageHole(PageItem *item, EPageHoleKind kind, const char *text, int arg)
+{
+    if(!omCompilingTemplate)
+        return false;
+    PageHole hole;
+    hole.item = item;
+    hole.kind = kind;
+    hole.text = text;
+    hole.arg = arg;
+    omCompilingTemplate->holes.push_back(hole);
+    return true;
+}
+
+/// the bytes of s, if it's in flash, which would otherwise be RAM.
+static int flashBytes(const char *s)
+{
+    return s && omIsFlash(s) ? (int)strlen_P(s) + 1 : 0;
+}
+
+/// name, or if it's in flash, a copy of it in buffer.
+static const char *ramName(const char *name, char *buffer, size_t size)
+{
+    if(!name || !omIsFlash(name))
+        return name;
+    size_t len = strlen_P(name);
+    if(len > size - 1)
+        len = size - 1;
+    memcpy_P(buffer, name, len);
+    buffer[len] = 0;
+    return buffer;
+}
+
+/// Action procs are sketch code, which compares and prints the names it's
+/// given and can't read flash; so names in flash go to it as RAM copies,
+/// good for the call. Two of them, which is why not omRam().
+static void callActionProc(OmWebActionProc proc, const char *pageName, const char *itemName, int value, int ref1, void *ref2)
+{
+    char pageBuffer[64];
+    char itemBuffer[64];
+    proc(ramName(pageName, pageBuffer, sizeof(pageBuffer)), ramName(itemName, itemBuffer, sizeof(itemBuffer)),
+         value, ref1, ref2);
+}
+
 class PageItem
 {
 public:
@@ -46,13 +229,28 @@ public:
     int ref1 = 0;
     void *ref2 = 0;
     int value = 0;
+    uint32_t valueSerial = 0; // when the value last changed, from omChangeSerialNext()
     bool visible = true;
+    Page *page = NULL; // the page it's on, told of changes so its cached rendering is dropped
     
     virtual void render(OmXmlWriter &w, Page *inPage, bool inBox = true) = 0;
     virtual bool doAction(Page *fromPage) = 0;
-    void setValue(int value) { this->value = value; }
+    /// true if it renders differently without being changed, like an HtmlProc, so the page can't be cached.
+    virtual bool isDynamic() { return false; }
+    /// bytes of its strings in flash, for "_info".
+    virtual int flashBytes() { return ::flashBytes(this->name); }
+    void setValue(int value)
+    {
+        if(value == this->value)
+            return;
+        this->value = value;
+        this->valueSerial = omChangeSerialNext();
+        this->touch();
+    }
+    void touch(); // after any change that shows on the page
+    void touchLayout(); // after a change to anything but the value
 
-    virtual void renderStatusey(OmXmlWriter &w)=0;// {};
+    virtual void renderStatusey(StatusWriter &w)=0;// {};
 
     OmWebPageItem item;
     PageItem() : item(this)
@@ -66,6 +264,29 @@ public:
     }
 
 protected:
+    /// The value through format, for the page. While the page is compiling to a
+    /// template, it's a marker instead, and the value is filled in at each render.
+    const char *valueText(const char *format)
+    {
+        if(addPageHole(this, PH_FORMAT, format, 0))
+            return PAGE_HOLE_MARK;
+        static char s[24];
+        sprintf(s, format, this->value);
+        return s;
+    }
+
+    /// Adds attribute="attribute" if the value is arg, or for PH_ATTRIBUTE_IF_BITS, has any of its bits.
+    void addValueAttribute(OmXmlWriter &w, const char *attribute, EPageHoleKind kind, int arg)
+    {
+        if(addPageHole(this, kind, attribute, arg))
+        {
+            w.endAttribute();
+            w.addContentRaw(PAGE_HOLE_MARK);
+        }
+        else if(kind == PH_ATTRIBUTE_IF_EQUAL ? this->value == arg : (this->value & arg) != 0)
+            w.addAttribute(attribute, attribute);
+    }
+
     void maybeBox1Start(OmXmlWriter &w, bool inBox)
     {
         if(inBox)
@@ -116,18 +337,23 @@ const char *OmWebPageItem::getName()
 void OmWebPageItem::setName(const char *name)
 {
     this->privateItem->name = name;
+    this->privateItem->touchLayout();
+    omItemNamesSerial++;
 }
 
 void OmWebPageItem::setVisible(bool visible)
 {
     this->privateItem->visible = visible;
+    this->privateItem->touchLayout();
 }
 
 void OmWebPageItem::setVisible(bool visible, const char *name, int value)
 {
     this->privateItem->visible = visible;
     this->privateItem->name = name;
-    this->privateItem->value = value;
+    this->privateItem->touchLayout();
+    omItemNamesSerial++;
+    this->privateItem->setValue(value);
 }
 
 
@@ -137,7 +363,7 @@ int OmWebPageItem::getValue()
 }
 void OmWebPageItem::setValue(int value)
 {
-    this->privateItem->value = value;
+    this->privateItem->setValue(value);
 }
 
 class Page
@@ -148,25 +374,52 @@ public:
         this->clearPage();
     }
 
+    /// The items live in the page's arena, so they all go at once, and the next
+    /// build of the page reuses the same blocks rather than churning the heap.
     void clearPage()
     {
         for(PageItem *item : this->items)
         {
             if(item)
-                delete item;
+                item->~PageItem();
         }
+        this->arena.reset();
         this->items.clear();
+        this->itemNames.clear();
+        this->itemNamesCount = 0;
+        this->dynamicItems = 0;
+        this->touchLayout();
+    }
+
+    void touchLayout()
+    {
+        this->version++;
+        this->layoutVersion++;
+        this->layoutSerial = omChangeSerialNext();
     }
 
     const char *name = "";
     bool listed;
     char id[6]; // simple mechanical id like p0 or p23.
+    uint32_t version = 0; // bumped by any change to the page or its items, for its ETag
+    uint32_t layoutVersion = 0; // bumped by changes other than item values, for its template
+    uint32_t templateTooBig = 0; // layoutVersion + 1 of a template that didn't fit the cache
+    uint32_t layoutVersionLastRequest = 0; // a template is only worth compiling once the layout holds still
+    uint32_t layoutSerial = 0; // omChangeSerialNext() of its last layout change, for "_status?since="
+    int dynamicItems = 0; // HtmlProcs and such; the page is rendered fresh each time if there are any
     /// this proc gets called before renderind. It could rebuild the whole page "just in case" for example.
     OmWebActionProc arrivalAction = NULL;
     int arrivalActionRef1 = 0;
     void *arrivalActionRef2 = 0;
 
     std::vector<PageItem *> items;
+    OmArena arena; // items, options and such, all reset by clearPage()
+
+    /// a new item, constructed in the arena.
+    template <class T> T *newItem()
+    {
+        return new(this->arena.alloc(sizeof(T))) T();
+    }
     
     // set to false to inhibit this pages's default header or footer.
     // replace with different via Html items if you like.
@@ -175,10 +428,46 @@ public:
     void addItem(PageItem *item)
     {
         sprintf(item->id, "i%d", (int)this->items.size());
+        item->page = this;
         this->items.push_back(item);
+        if(item->isDynamic())
+            this->dynamicItems++;
+        this->touchLayout();
+    }
+
+    /// item by name. Names may be assigned after addItem(), or changed later, so
+    /// the index is brought up to date here, when it's needed, rather than there.
+    PageItem *findItem(const char *itemName)
+    {
+        if(this->itemNamesCount != this->items.size() || this->itemNamesSerial != omItemNamesSerial)
+        {
+            this->itemNames.clear();
+            for(PageItem *item : this->items)
+                this->itemNames.add(item->name, item);
+            this->itemNamesCount = this->items.size();
+            this->itemNamesSerial = omItemNamesSerial;
+        }
+        return (PageItem *)this->itemNames.find(itemName);
     }
+
+private:
+    OmNameIndex itemNames;
+    size_t itemNamesCount = 0;
+    int itemNamesSerial = 0;
 };
 
+void PageItem::touch()
+{
+    if(this->page)
+        this->page->version++;
+}
+
+void PageItem::touchLayout()
+{
+    if(this->page)
+        this->page->touchLayout();
+}
+
 class PageLink : public PageItem
 {
 public:
@@ -188,7 +477,7 @@ public:
     void render(OmXmlWriter &w, Page *inPage, bool inBox) override
     {
         w.beginElement("a");
-        w.addAttributeUrlF("href", "/%s?page=%s&item=%s", this->pageLink, inPage->id, this->id);
+        w.addAttributeUrlF("href", "/%s?page=%s&item=%s", omRam(this->pageLink), inPage->id, this->id);
         
         w.beginElement("div");
         w.addAttribute("class", this->mini ? "box2" : "box1");
@@ -202,7 +491,7 @@ public:
     {
         if(this->proc)
         {
-            this->proc(fromPage->name, this->id, 0, this->ref1, this->ref2);
+            callActionProc(this->proc, fromPage->name, this->id, 0, this->ref1, this->ref2);
             return true;
         }
         else
@@ -211,9 +500,9 @@ public:
         }
     }
 
-    void renderStatusey(OmXmlWriter &w) override
+    void renderStatusey(StatusWriter &w) override
     {
-        w.addAttribute("kind", "pageLink");
+        w.add("kind", "pageLink");
     }
 };
 
@@ -241,10 +530,10 @@ public:
         w.beginElement("span", "class", "sliderValue");
         w.addAttribute("style", "margin-bottom:15px");
         w.addAttributeF("id", "%s_%s_value", inPage->id, this->id);
-        w.addContentF("%d", this->value);
+        w.addContentF("%s", this->valueText("%d"));
         w.endElement(); // span
         w.beginElement("input", "type", "range");
-        w.addAttributeF("value", "%d", this->value);
+        w.addAttributeF("value", "%s", this->valueText("%d"));
         w.addAttribute("style", "width: 330px");
         w.addAttributeF("id", "%s_%s", inPage->id, this->id);
         w.addAttributeF("onchange", "sliderInput(this,'%s', '%s')", inPage->id, this->id);
@@ -262,7 +551,7 @@ public:
     {
         if(this->proc)
         {
-            this->proc(fromPage->name, this->name, this->value, this->ref1, this->ref2);
+            callActionProc(this->proc, fromPage->name, this->name, this->value, this->ref1, this->ref2);
             return true;
         }
         else
@@ -271,11 +560,11 @@ public:
         }
     }
 
-    void renderStatusey(OmXmlWriter &w) override
+    void renderStatusey(StatusWriter &w) override
     {
-        w.addAttribute("kind", "slider");
-        w.addAttribute("min", this->min);
-        w.addAttribute("max", this->max);
+        w.add("kind", "slider");
+        w.add("min", this->min);
+        w.add("max", this->max);
     }
 };
 
@@ -312,14 +601,13 @@ public:
 ////        w.addContentF("%s", minutesToTimeString(this->value));
 //        w.endElement(); // span
         w.beginElement("input", "type", "time");
-        w.addAttributeF("value", "%s", minutesToTimeString(this->value));
+        w.addAttributeF("value", "%s", addPageHole(this, PH_TIME, NULL, 0) ? PAGE_HOLE_MARK : minutesToTimeString(this->value));
         w.addAttributeF("id", "%s_%s", inPage->id, this->id);
         w.addAttributeF("onchange", "timeChange(this,'%s', '%s')", inPage->id, this->id);
         w.endElement(); // input
         w.beginElement("input", "type", "checkbox");
         w.addAttributeF("id", "%s_%s_checkbox", inPage->id, this->id);
-        if(this->value & 0x8000)
-            w.addAttribute("checked", "checked");
+        this->addValueAttribute(w, "checked", PH_ATTRIBUTE_IF_BITS, 0x8000);
         w.addAttributeF("onchange", "timeChange(this,'%s', '%s')", inPage->id, this->id);
         w.endElement();
         w.endElement(); // form
@@ -330,7 +618,7 @@ public:
     {
         if(this->proc)
         {
-            this->proc(fromPage->name, this->name, this->value, this->ref1, this->ref2);
+            callActionProc(this->proc, fromPage->name, this->name, this->value, this->ref1, this->ref2);
             return true;
         }
         else
@@ -339,9 +627,30 @@ public:
         }
     }
 
-    void renderStatusey(OmXmlWriter &w) override
+    void renderStatusey(StatusWriter &w) override
+    {
+        w.add("kind", "time");
+    }
+};
+
+/// A select's option or a checkbox, in a list in the page's arena.
+class PageOption
+{
+public:
+    const char *name;
+    int number;
+    PageOption *next;
+
+    static PageOption *append(Page *page, PageOption **listInOut, const char *name, int number)
     {
-        w.addAttribute("kind", "time");
+        PageOption *option = new(page->arena.alloc(sizeof(PageOption))) PageOption();
+        option->name = name;
+        option->number = number;
+        option->next = NULL;
+        while(*listInOut)
+            listInOut = &(*listInOut)->next;
+        *listInOut = option;
+        return option;
     }
 };
 
@@ -349,14 +658,28 @@ class PageSelect : public PageItem
 {
 public:
     OmWebActionProc proc = 0;
-    std::vector<const char*> optionNames;
-    std::vector<int> optionNumbers;
+    PageOption *options = NULL;
     const char *url = "_";
 
     void addOption(const char *optionName, int optionNumber)
     {
-        this->optionNames.push_back(optionName);
-        this->optionNumbers.push_back(optionNumber);
+        PageOption::append(this->page, &this->options, optionName, optionNumber);
+    }
+
+    int flashBytes() override
+    {
+        int result = PageItem::flashBytes();
+        for(PageOption *option = this->options; option; option = option->next)
+            result += ::flashBytes(option->name);
+        return result;
+    }
+
+    bool hasOption(int optionNumber)
+    {
+        for(PageOption *option = this->options; option; option = option->next)
+            if(option->number == optionNumber)
+                return true;
+        return false;
     }
 
     void render(OmXmlWriter &w, Page *inPage, bool inBox) override
@@ -378,22 +701,25 @@ public:
         w.addAttributeF("onchange", "selectChange(this,'%s', '%s', '%s%s')", inPage->id, this->id, maybeUrlBase, url);
 
         bool foundSelectedOption = false;
-        for(unsigned int ix = 0; ix < this->optionNumbers.size(); ix++)
+        for(PageOption *option = this->options; option; option = option->next)
         {
             w.beginElement("option");
-            int optionNumber = this->optionNumbers[ix]; // the integer assigned to this menu choice
+            int optionNumber = option->number; // the integer assigned to this menu choice
             w.addAttributeF("value", "%d", optionNumber);
+            this->addValueAttribute(w, "selected", PH_ATTRIBUTE_IF_EQUAL, optionNumber);
             if(this->value == optionNumber)
-            {
-                w.addAttribute("selected", "selected");
                 foundSelectedOption = true;
-            }
-            w.addContent(this->optionNames[ix]);
+            w.addContent(option->name);
             w.endElement();
         }
 
         // if somehow the current value isn't one of the choices, add it here to show ya.
-        if(!foundSelectedOption)
+        if(addPageHole(this, PH_SELECT_EXTRA, NULL, 0))
+        {
+            w.addContent(""); // as beginElement("option") would close the <select
+            w.addContentRaw(PAGE_HOLE_MARK);
+        }
+        else if(!foundSelectedOption)
         {
             w.beginElement("option");
             w.addAttribute("selected", "selected");
@@ -405,7 +731,7 @@ public:
         w.endElement(); // select
         w.beginElement("span", "class", "selectValue");
         w.addAttributeF("id", "%s_%s_value", inPage->id, this->id);
-        w.addContentF(" %d", this->value);
+        w.addContentF("%s", this->valueText(" %d"));
         w.endElement(); // span
         this->maybeBox1End(w, inBox);
     }
@@ -414,7 +740,7 @@ public:
     {
         if(this->proc)
         {
-            this->proc(fromPage->name, this->name, this->value, this->ref1, this->ref2);
+            callActionProc(this->proc, fromPage->name, this->name, this->value, this->ref1, this->ref2);
             return true;
         }
         else
@@ -423,9 +749,9 @@ public:
         }
     }
 
-    void renderStatusey(OmXmlWriter &w) override
+    void renderStatusey(StatusWriter &w) override
     {
-        w.addAttribute("kind", "pageSelect");
+        w.add("kind", "pageSelect");
     }
 };
 
@@ -440,16 +766,29 @@ class PageCheckboxes : public PageItem
 {
 public:
     OmWebActionProc proc = 0;
-    std::vector<String> checkboxNames; // checkbox values start at bit 0 and work up.
+    PageOption *checkboxes = NULL; // checkbox values start at bit 0 and work up.
+    int checkboxCount = 0;
 
-    void addCheckbox(String checkboxName, int value)
+    void addCheckbox(const char *checkboxName, int value)
     {
         // add the boolean value for this checkbox. later ones are higher bits.
         value = value ? 1 : 0;
-        value <<= this->checkboxNames.size();
+        value <<= this->checkboxCount;
         this->value |= value;
 
-        this->checkboxNames.push_back(checkboxName);
+        // the name is copied, as it always has been, so it can be built on the fly. But not from flash.
+        if(!omIsFlash(checkboxName))
+            checkboxName = this->page->arena.copyString(checkboxName);
+        PageOption::append(this->page, &this->checkboxes, checkboxName, this->checkboxCount);
+        this->checkboxCount++;
+    }
+
+    int flashBytes() override
+    {
+        int result = PageItem::flashBytes();
+        for(PageOption *checkbox = this->checkboxes; checkbox; checkbox = checkbox->next)
+            result += ::flashBytes(checkbox->name);
+        return result;
     }
 
     void render(OmXmlWriter &w, Page *inPage, bool inBox) override
@@ -465,7 +804,7 @@ public:
 
         // list of all the checkboxes in this group, like "controls_components_checkbox_1,controls_components_checkbox_2,controls_components_checkbox_3"
         String checkboxesAll;
-        for(unsigned int ix = 0; ix < this->checkboxNames.size(); ix++)
+        for(int ix = 0; ix < this->checkboxCount; ix++)
         {
             if(ix)
                 checkboxesAll += ",";
@@ -476,25 +815,25 @@ public:
             checkboxesAll += intToString(ix);
         }
         uint32_t bit = 1;
-        for(unsigned int ix = 0; ix < this->checkboxNames.size(); ix++)
+        for(PageOption *checkbox = this->checkboxes; checkbox; checkbox = checkbox->next)
         {
+            int ix = checkbox->number;
             w.addElement("br");
             w.beginElement("input");
             w.addAttributeF("id", "%s_%s_checkbox_%d", inPage->id, this->id, ix);
             w.addAttribute("type", "checkbox");
             w.addAttributeF("value", "%d", bit);
-            if(bit & this->value)
-                w.addAttribute("checked", "checked");
+            this->addValueAttribute(w, "checked", PH_ATTRIBUTE_IF_BITS, bit);
             w.addAttributeF("onchange", "checkboxChange('%s', '%s', '%s')", inPage->id, this->id, checkboxesAll.c_str());
             w.endElement("input");
             w.beginElement("span", "class", "checkboxLabel");
-            w.addContent(this->checkboxNames[ix].c_str());
+            w.addContent(checkbox->name);
             w.endElement();
             bit = bit + bit;
         }
         w.beginElement("span", "class", "selectValue");
         w.addAttributeF("id", "%s_%s_value", inPage->id, this->id);
-        w.addContentF(" %d", this->value);
+        w.addContentF("%s", this->valueText(" %d"));
         w.endElement(); // span
         this->maybeBox1End(w, inBox);
     }
@@ -503,7 +842,7 @@ public:
     {
         if(this->proc)
         {
-            this->proc(fromPage->name, this->name, this->value, this->ref1, this->ref2);
+            callActionProc(this->proc, fromPage->name, this->name, this->value, this->ref1, this->ref2);
             return true;
         }
         else
@@ -512,16 +851,13 @@ public:
         }
     }
 
-    void renderStatusey(OmXmlWriter &w) override
+    void renderStatusey(StatusWriter &w) override
     {
-        w.addAttribute("kind", "checkboxes");
-        String s = "";
-        for(auto cn : this->checkboxNames)
-        {
-            if(s.length()) s += ",";
-            s += cn;
-        }
-        w.addAttribute("checkboxNames", s.c_str());
+        w.add("kind", "checkboxes");
+        w.beginValue("checkboxNames");
+        for(PageOption *checkbox = this->checkboxes; checkbox; checkbox = checkbox->next)
+            w.putF(checkbox->number ? ",%s" : "%s", checkbox->name);
+        w.endValue();
     }
 };
 
@@ -544,7 +880,7 @@ public:
         this->maybeBox1Start(w, inBox);
         w.beginElement("form");
         w.beginElement("input", "type", "color");
-        w.addAttributeF("value", "#%06x", this->value);
+        w.addAttributeF("value", "%s", this->valueText("#%06x"));
         w.addAttributeF("id", "%s_%s", inPage->id, this->id);
         // change just like a slider -- it's a numeric value... ish.
         w.addAttributeF("onchange", "colorInput(this,'%s', '%s')", inPage->id, this->id);
@@ -553,7 +889,7 @@ public:
 
         w.beginElement("span", "class", "colorValue");
         w.addAttributeF("id", "%s_%s_value", inPage->id, this->id);
-        w.addContentF(" #%06x", this->value);
+        w.addContentF("%s", this->valueText(" #%06x"));
         w.endElement(); // span
 
         w.endElement(); // form
@@ -564,7 +900,7 @@ public:
     {
         if(this->proc)
         {
-            this->proc(fromPage->name, this->name, this->value, this->ref1, this->ref2);
+            callActionProc(this->proc, fromPage->name, this->name, this->value, this->ref1, this->ref2);
             return true;
         }
         else
@@ -573,9 +909,9 @@ public:
         }
     }
 
-    void renderStatusey(OmXmlWriter &w) override
+    void renderStatusey(StatusWriter &w) override
     {
-        w.addAttribute("kind", "color");
+        w.add("kind", "color");
     }
 };
 
@@ -604,18 +940,18 @@ public:
         w.endElement();
     }
 
-    void renderStatusey(OmXmlWriter &w) override
+    void renderStatusey(StatusWriter &w) override
     {
-        w.addAttribute("kind", "button");
+        w.add("kind", "button");
         if(!omStringEqual(this->url, "_"))
-            w.addAttribute("url", this->url);
+            w.add("url", this->url);
     }
 
     bool doAction(Page *fromPage) override
     {
         if(this->proc)
         {
-            this->proc(fromPage->name, this->name, this->value, this->ref1, this->ref2);
+            callActionProc(this->proc, fromPage->name, this->name, this->value, this->ref1, this->ref2);
             return true;
         }
         else
@@ -637,30 +973,38 @@ public:
         if(this->proc)
             this->proc(w, this->ref1, this->ref2);
     }
+    bool isDynamic() override
+    {
+        return true;
+    }
     bool doAction(Page *fromPage) override
     {
         return true;
     }
 
-    void renderStatusey(OmXmlWriter &w) override
+    void renderStatusey(StatusWriter &w) override
     {
-        w.addAttribute("kind", "html");
+        w.add("kind", "html");
     }
 };
 
 class StaticHtmlItem : public PageItem
 {
 public:
-    String staticHtml;
+    const char *staticHtml = ""; // copied into the page's arena
 
     void render(OmXmlWriter &w, Page *inPage, bool inBox) override
     {
         UNUSED(inPage);
-        w.addRawContent(this->staticHtml.c_str());
+        w.addRawContent(this->staticHtml);
     }
-    void renderStatusey(OmXmlWriter &w) override
+    int flashBytes() override
     {
-        w.addAttribute("kind", "htmlStatic");
+        return ::flashBytes(this->staticHtml);
+    }
+    void renderStatusey(StatusWriter &w) override
+    {
+        w.add("kind", "htmlStatic");
     }
     bool doAction(Page *fromPage) override
     {
@@ -668,6 +1012,317 @@ public:
     }
 };
 
+static uint8_t *pageCacheAlloc(int size)
+{
+#if defined(ARDUINO_ARCH_ESP32) && defined(BOARD_HAS_PSRAM)
+    if(psramFound())
+        return (uint8_t *)ps_malloc(size);
+#endif
+    return (uint8_t *)malloc(size);
+}
+
+/// Compiled page templates, good until their page's layout or the site changes. Least recently used go first.
+class PageCache
+{
+public:
+    class Entry
+    {
+    public:
+        Page *page = NULL;
+        uint32_t stamp = 0; // from the layout versions it was compiled at; stale once they move
+        PageTemplate *pageTemplate = NULL;
+        int size = 0;
+        uint32_t lastUsed = 0;
+    };
+
+    std::vector<Entry> entries;
+    int budget = OMWP_PAGE_CACHE_BYTES;
+    int used = 0;
+    uint32_t clock = 0;
+
+    PageCache()
+    {
+#if defined(ARDUINO_ARCH_ESP32) && defined(BOARD_HAS_PSRAM)
+        if(!psramFound() && this->budget > 16384)
+            this->budget = 16384; // a psram board without the psram fitted
+#endif
+    }
+
+    ~PageCache()
+    {
+        this->setBudget(0);
+    }
+
+    PageTemplate *find(Page *page, uint32_t stamp)
+    {
+        for(Entry &entry : this->entries)
+        {
+            if(entry.page == page)
+            {
+                if(entry.stamp != stamp)
+                    return NULL;
+                entry.lastUsed = ++this->clock;
+                return entry.pageTemplate;
+            }
+        }
+        return NULL;
+    }
+
+    /// Takes the template, and deletes it now if it doesn't fit.
+    PageTemplate *add(Page *page, uint32_t stamp, PageTemplate *pageTemplate)
+    {
+        this->remove(page); // any older compilation
+        int size = pageTemplate->memorySize();
+        if(size > this->budget)
+        {
+            delete pageTemplate;
+            return NULL;
+        }
+        this->evictTo(this->budget - size);
+        Entry entry;
+        entry.page = page;
+        entry.stamp = stamp;
+        entry.pageTemplate = pageTemplate;
+        entry.size = size;
+        entry.lastUsed = ++this->clock;
+        this->entries.push_back(entry);
+        this->used += size;
+        return pageTemplate;
+    }
+
+    void setBudget(int budget)
+    {
+        this->budget = budget > 0 ? budget : 0;
+        this->evictTo(this->budget);
+    }
+
+private:
+    void remove(Page *page)
+    {
+        for(size_t ix = 0; ix < this->entries.size(); ix++)
+        {
+            if(this->entries[ix].page == page)
+            {
+                this->removeAt(ix);
+                return;
+            }
+        }
+    }
+
+    void removeAt(size_t ix)
+    {
+        this->used -= this->entries[ix].size;
+        delete this->entries[ix].pageTemplate;
+        this->entries.erase(this->entries.begin() + ix);
+    }
+
+    void evictTo(int size)
+    {
+        while(this->used > size && this->entries.size())
+        {
+            size_t oldest = 0;
+            for(size_t ix = 1; ix < this->entries.size(); ix++)
+                if(this->entries[ix].lastUsed < this->entries[oldest].lastUsed)
+                    oldest = ix;
+            this->removeAt(oldest);
+        }
+    }
+};
+
+/// Counts what's written, and goes no further. For a Content-Length before the real rendering.
+class OmCountingStream : public OmIByteStream
+{
+public:
+    size_t count = 0;
+
+    bool put(uint8_t ch) override
+    {
+        this->count++;
+        return true;
+    }
+
+    bool putN(const uint8_t *data, size_t size) override
+    {
+        this->count += size;
+        return true;
+    }
+};
+
+/// Keeps what's written, up to a limit, for compiling into a template.
+class PageCaptureStream : public OmIByteStream
+{
+public:
+    std::vector<uint8_t> bytes;
+    size_t limit;
+    bool overflowed = false;
+
+    PageCaptureStream(size_t limit) : limit(limit) {}
+
+    bool put(uint8_t ch) override
+    {
+        return this->putN(&ch, 1);
+    }
+
+    bool putN(const uint8_t *data, size_t size) override
+    {
+        if(this->overflowed)
+            return true;
+        if(this->bytes.size() + size > this->limit)
+        {
+            this->overflowed = true;
+            std::vector<uint8_t>().swap(this->bytes); // give the memory back now
+            return true;
+        }
+        this->bytes.insert(this->bytes.end(), data, data + size);
+        return true;
+    }
+};
+
+/// Moves the recorded page into a template, taking out the hole markers and
+/// noting where they were. NULL if the markers and holes don't line up, which
+/// means something else on the page had a marker byte in it.
+static PageTemplate *compilePageTemplate(PageCaptureStream &recording, PageTemplate *t)
+{
+    size_t holeIx = 0;
+    uint32_t size = 0;
+    uint8_t *bytes = recording.bytes.data();
+    for(uint8_t ch : recording.bytes)
+    {
+        if(ch == PAGE_HOLE_MARK[0])
+        {
+            if(holeIx >= t->holes.size())
+                return NULL;
+            t->holes[holeIx++].at = size;
+        }
+        else
+            bytes[size++] = ch;
+    }
+    if(holeIx != t->holes.size())
+        return NULL;
+    t->bytes = pageCacheAlloc(size ? size : 1);
+    if(!t->bytes)
+        return NULL;
+    memcpy(t->bytes, bytes, size);
+    t->size = size;
+    return t;
+}
+
+/// The page, from its template and the items' current values.
+static void renderPageTemplate(OmXmlWriter &w, PageTemplate *t)
+{
+    w.minifiedBytes += t->minifiedBytes;
+    uint32_t at = 0;
+    char s[96];
+    for(PageHole &hole : t->holes)
+    {
+        w.putN(t->bytes + at, hole.at - at);
+        at = hole.at;
+        int value = hole.item ? hole.item->value : 0;
+        s[0] = 0;
+        switch(hole.kind)
+        {
+            case PH_FORMAT:
+                sprintf(s, hole.text, value);
+                break;
+            case PH_TIME:
+                strcpy(s, PageTime::minutesToTimeString(value));
+                break;
+            case PH_ATTRIBUTE_IF_EQUAL:
+            case PH_ATTRIBUTE_IF_BITS:
+                if(hole.kind == PH_ATTRIBUTE_IF_EQUAL ? value == hole.arg : (value & hole.arg) != 0)
+                    sprintf(s, " %s=\"%s\"", hole.text, hole.text);
+                break;
+            case PH_SELECT_EXTRA:
+                if(!((PageSelect *)hole.item)->hasOption(value))
+                    sprintf(s, "<option selected=\"selected\" disabled=\"disabled\">(%d)</option>", value);
+                break;
+            case PH_VALUE_SERIAL:
+                sprintf(s, "%u", (unsigned int)omChangeSerial());
+                break;
+        }
+        w.putS(s);
+    }
+    w.putN(t->bytes + at, t->size - at);
+}
+
+/// One of the numbers "_perf" keeps, as a histogram in powers of 4: bucket k
+/// counts values from 4^k to 4^(k+1)-1, except bucket 0 starts at 0, and the
+/// last takes everything bigger. Counts stick at 65535.
+class PerfHistogram
+{
+public:
+    static const int kBuckets = 12; // the last starts at 4^11, about 4 million: 4 seconds, or 4 megabytes
+    uint32_t count = 0;
+    uint32_t max = 0;
+    uint64_t sum = 0;
+    uint16_t buckets[kBuckets] = {0};
+
+    static uint32_t bucketStart(int k)
+    {
+        return k ? 1u << (2 * k) : 0;
+    }
+
+    void add(uint32_t value)
+    {
+        int k = 0;
+        while(k < kBuckets - 1 && (value >> (2 * (k + 1))))
+            k++;
+        if(this->buckets[k] < 0xffff)
+            this->buckets[k]++;
+        this->count++;
+        this->sum += value;
+        if(value > this->max)
+            this->max = value;
+    }
+
+    uint32_t average()
+    {
+        return this->count ? (uint32_t)(this->sum / this->count) : 0;
+    }
+};
+
+/// What "_perf" knows about one route.
+class PerfRoute
+{
+public:
+    const char *route = ""; // a page's name, a url handler's path, or one of ours like "_control"
+    PerfRoute *next = 0;
+    uint32_t requests = 0;
+    uint32_t errors = 0; // the writer's errors, or the client not taking every byte
+    PerfHistogram parseMicros; // the server reading the headers, and us the query
+    PerfHistogram renderMicros; // everything after that up to the last byte, actions included
+    PerfHistogram bytes;
+    PerfHistogram stallMicros; // blocked in the socket's writes; only when the server says
+
+    void reset()
+    {
+        this->requests = 0;
+        this->errors = 0;
+        this->parseMicros = PerfHistogram();
+        this->renderMicros = PerfHistogram();
+        this->bytes = PerfHistogram();
+        this->stallMicros = PerfHistogram();
+    }
+
+    /// all the time this route has taken, to find the expensive ones
+    uint64_t busyMicros()
+    {
+        return this->parseMicros.sum + this->renderMicros.sum + this->stallMicros.sum;
+    }
+};
+
+/// different every boot, so a browser's ETag from before a restart can't match a page rendered since.
+static uint32_t omBootNonce()
+{
+#if defined(ARDUINO_ARCH_ESP32)
+    return esp_random();
+#elif defined(ARDUINO_ARCH_ESP8266)
+    return RANDOM_REG32;
+#else
+    return (uint32_t)time(NULL);
+#endif
+}
+
 void infoHtmlProc(OmXmlWriter &w, int ref1, void *ref2)
 {
     UNUSED(ref1);
@@ -675,11 +1330,44 @@ void infoHtmlProc(OmXmlWriter &w, int ref1, void *ref2)
     owp->renderInfo(w);
 }
 
+/// ref1 is 1 for "_status.json", 2 for "_status.bin"
 void statusXmlProc(OmXmlWriter &w, OmWebRequest &request, int ref1, void *ref2)
 {
     OmWebPages *owp = (OmWebPages *)ref2;
     const char *text = request.getValue("text");
-    owp->renderStatusXml(w, text != NULL);
+    const char *since = request.getValue("since");
+    uint32_t sinceSerial = since ? (uint32_t)strtoul(since, NULL, 10) : 0;
+    if(ref1 == 2)
+        owp->renderStatusBin(w, sinceSerial);
+    else if(ref1 && since)
+        owp->renderStatusJsonSince(w, text != NULL, sinceSerial);
+    else if(ref1)
+        owp->renderStatusJson(w, text != NULL);
+    else if(since)
+        owp->renderStatusXmlSince(w, text != NULL, sinceSerial);
+    else
+        owp->renderStatusXml(w, text != NULL);
+}
+
+/// ref1 is 1 for "_perf.json". "?reset=1" starts the numbers over, after showing them.
+void perfProc(OmXmlWriter &w, OmWebRequest &request, int ref1, void *ref2)
+{
+    OmWebPages *owp = (OmWebPages *)ref2;
+    owp->renderPerf(w, ref1 != 0);
+    if(request.getValue("reset"))
+        owp->resetPerf();
+}
+
+void styleFileProc(OmXmlWriter &w, OmWebRequest &request, int ref1, void *ref2)
+{
+    OmWebPages *owp = (OmWebPages *)ref2;
+    owp->renderStyleFile(w, omStringEqual(request.getValue("min"), "0"));
+}
+
+void scriptFileProc(OmXmlWriter &w, OmWebRequest &request, int ref1, void *ref2)
+{
+    OmWebPages *owp = (OmWebPages *)ref2;
+    owp->renderScriptFile(w, omStringEqual(request.getValue("min"), "0"));
 }
 
 void defaultFooterHtmlProc(OmXmlWriter &w, int ref1, void *ref2)
@@ -691,6 +1379,8 @@ void defaultFooterHtmlProc(OmXmlWriter &w, int ref1, void *ref2)
 OmWebPages::OmWebPages()
 {
     OmWebPages::p = this; // reference to last one made. really, the only one.
+    this->pageCache = new PageCache();
+    this->pageEtagNonce = omBootNonce();
     this->__date__ = __DATE__;
     this->__time__ = __TIME__;
     this->__file__ = NULL;
@@ -706,22 +1396,30 @@ OmWebPages::OmWebPages()
 
     // Add the poll-able xml status page, to allow local discover.
     this->addUrlHandler("_status", statusXmlProc, 0, this);
+    this->addUrlHandler("_status.json", statusXmlProc, 1, this);
+    this->addUrlHandler("_status.bin", statusXmlProc, 2, this);
+
+    // Where the time goes, by route.
+    this->addUrlHandler("_perf", perfProc, 0, this);
+    this->addUrlHandler("_perf.json", perfProc, 1, this);
+
+    // The style and script every page uses, served separately so the browser can cache them.
+    this->addUrlHandler("_om.css", styleFileProc, 0, this);
+    this->addUrlHandler("_om.js", scriptFileProc, 0, this);
 }
 
 OmWebPages::~OmWebPages()
 {
+    // pages and url handlers are in the site arena, which goes when we do.
     for(Page *page : this->pages)
     {
         if(page)
-            delete page;
+            page->~Page();
     }
     this->pages.clear();
-    
-    for(UrlHandler *handler : this->urlHandlers)
-    {
-        delete handler;
-    }
     this->urlHandlers.clear();
+
+    delete this->pageCache;
 }
 
 void OmWebPages::setBuildDateAndTime(const char *date, const char *time, const char *file)
@@ -748,24 +1446,29 @@ void *OmWebPages::beginPage(const char *pageName, bool listed)
     // if a page with this name already exists, clear out its contents so
     // you can replace them with new elements.
     void *oldPage = this->currentPage;
-    for(Page *aPage : this->pages)
-    {
-        if(omStringEqual(pageName, aPage->name))
-        {
-            aPage->clearPage();
-            this->currentPage = aPage;
-            aPage->listed = listed;
-            goto goHome;
-        }
+    Page *aPage = (Page *)this->pageNames.find(pageName);
+    if(aPage)
+    {
+        // Rebuilding a page, as an arrival action might on every request, only
+        // changes that page. Unless it's listed or unlisted, then the footers change.
+        aPage->clearPage();
+        this->currentPage = aPage;
+        if(aPage->listed != listed)
+            this->siteVersion++;
+        aPage->listed = listed;
+        goto goHome;
     }
+    this->siteVersion++; // the page list is in every page's footer
 
     // It is indeed a brand new page. Let's create it.
     {
-        Page *page = new Page();
+        Page *page = new(this->siteArena.alloc(sizeof(Page))) Page();
         page->name = pageName;
         page->listed = listed;
         sprintf(page->id, "p%d", (int)this->pages.size());
+        page->layoutSerial = omChangeSerialNext();
         this->pages.push_back(page);
+        this->pageNames.add(page->name, page);
         this->currentPage = page;
         if(!this->homePage)
             this->homePage = page;
@@ -794,26 +1497,30 @@ void OmWebPages::resumePage(void *previousPage)
 void OmWebPages::allowHeader(bool allowHeader)
 {
     this->currentPage->allowHeader = allowHeader;
+    this->currentPage->touchLayout();
 }
 
 void OmWebPages::allowFooter(bool allowFooter)
 {
     this->currentPage->allowFooter = allowFooter;
+    this->currentPage->touchLayout();
 }
 
 void OmWebPages::setHeaderProc(OmHtmlProc headerProc)
 {
     this->headerProc = headerProc;
+    this->siteVersion++;
 }
 
 void OmWebPages::setFooterProc(OmHtmlProc footerProc)
 {
     this->footerProc = footerProc;
+    this->siteVersion++;
 }
 
 void OmWebPages::addPageLink(const char *pageLink, OmWebActionProc proc, int ref1, void *ref2)
 {
-    PageLink *b = new PageLink();
+    PageLink *b = this->currentPage->newItem<PageLink>();
     b->name = pageLink;
     b->pageLink = pageLink;
     b->proc = proc;
@@ -824,7 +1531,7 @@ void OmWebPages::addPageLink(const char *pageLink, OmWebActionProc proc, int ref
 
 void OmWebPages::addPageLinkMini(const char *pageLink, const char *label)
 {
-    PageLink *b = new PageLink();
+    PageLink *b = this->currentPage->newItem<PageLink>();
     b->name = label;
     b->pageLink = pageLink;
     b->mini = true;
@@ -833,7 +1540,7 @@ void OmWebPages::addPageLinkMini(const char *pageLink, const char *label)
 
 OmWebPageItem *OmWebPages::addButton(const char *buttonName, OmWebActionProc proc, int ref1, void *ref2)
 {
-    PageButton *b = new PageButton();
+    PageButton *b = this->currentPage->newItem<PageButton>();
     b->name = buttonName;
     b->proc = proc;
     b->ref1 = ref1;
@@ -857,7 +1564,7 @@ OmWebPageItem *OmWebPages::addSlider(const char *itemName, OmWebActionProc proc,
 
 OmWebPageItem *OmWebPages::addSlider(int rangeLow, int rangeHigh, const char *itemName, OmWebActionProc proc, int value, int ref1, void *ref2)
 {
-    PageSlider *p = new PageSlider();
+    PageSlider *p = this->currentPage->newItem<PageSlider>();
     p->name = itemName;
     p->value = value;
     p->ref1 = ref1;
@@ -871,7 +1578,7 @@ OmWebPageItem *OmWebPages::addSlider(int rangeLow, int rangeHigh, const char *it
 
 OmWebPageItem *OmWebPages::addTime(const char *itemName, OmWebActionProc proc, int value, int ref1, void *ref2)
 {
-    PageTime *p = new PageTime();
+    PageTime *p = this->currentPage->newItem<PageTime>();
     p->name = itemName;
     p->value = value;
     p->ref1 = ref1;
@@ -883,7 +1590,7 @@ OmWebPageItem *OmWebPages::addTime(const char *itemName, OmWebActionProc proc, i
 
 OmWebPageItem *OmWebPages::addColor(const char *itemName, OmWebActionProc proc, int value, int ref1, void *ref2)
 {
-    PageColor *p = new PageColor();
+    PageColor *p = this->currentPage->newItem<PageColor>();
     p->name = itemName;
     p->value = value;
     p->ref1 = ref1;
@@ -900,7 +1607,7 @@ OmWebPageItem *OmWebPages::addSelect(const char *itemName, OmWebActionProc proc,
 
 OmWebPageItem *OmWebPages::addSelectWithLink(const char *itemName, const char *url, OmWebActionProc proc, int value, int ref1, void *ref2)
 {
-    PageSelect *p = new PageSelect();
+    PageSelect *p = this->currentPage->newItem<PageSelect>();
     p->name = itemName;
     p->url = url;
     p->value = value;
@@ -918,12 +1625,13 @@ void OmWebPages::addSelectOption(const char *optionName, int optionValue)
     {
         PageSelect *select = (PageSelect *)this->currentSelect;
         select->addOption(optionName, optionValue);
+        select->touchLayout();
     }
 }
 
 OmWebPageItem *OmWebPages::addCheckbox(const char *itemName, const char *checkboxName, OmWebActionProc proc, int value, int ref1, void *ref2)
 {
-    PageCheckboxes *p = new PageCheckboxes();
+    PageCheckboxes *p = this->currentPage->newItem<PageCheckboxes>();
     p->name = itemName;
     p->value = 0;
     p->ref1 = ref1;
@@ -942,12 +1650,13 @@ void OmWebPages::addCheckboxX(const char *checkboxName, int value)
     {
         PageCheckboxes *p = (PageCheckboxes *)this->currentCheckboxes;
         p->addCheckbox(checkboxName, value);
+        p->touchLayout();
     }
 }
 
 void OmWebPages::addHtml(OmHtmlProc proc, int ref1, void *ref2)
 {
-    HtmlItem *h = new HtmlItem();
+    HtmlItem *h = this->currentPage->newItem<HtmlItem>();
     h->name = "_";
     h->ref1 = ref1;
     h->ref2 = ref2;
@@ -957,161 +1666,357 @@ void OmWebPages::addHtml(OmHtmlProc proc, int ref1, void *ref2)
 
 void OmWebPages::addStaticHtml(String staticHtml)
 {
-    StaticHtmlItem *h = new StaticHtmlItem();
-    h->staticHtml = staticHtml;
+    StaticHtmlItem *h = this->currentPage->newItem<StaticHtmlItem>();
+    h->staticHtml = this->currentPage->arena.copyString(staticHtml.c_str());
     this->currentPage->addItem(h);
 }
 
-bool OmWebPages::doAction(const char *pageName, const char *itemId)
+// The flash string versions. The names are used as they are, in flash.
+
+void *OmWebPages::beginPage(const __FlashStringHelper *pageName, bool listed)
 {
-    Page *page = this->findPage(pageName, true);
-    PageItem *item = this->findPageItem(pageName, itemId, true);
-    if(item)
-    {
-        return item->doAction(page);
-    }
-    return false;
+    return this->beginPage((const char *)pageName, listed);
 }
 
-void OmWebPages::renderStatusXml(OmXmlWriter &w, bool asText)
+void OmWebPages::addPageLink(const __FlashStringHelper *pageLink, OmWebActionProc proc, int ref1, void *ref2)
 {
-    if(asText)
-        this->renderHttpResponseHeader("text/plain", 200);
-    else
-        this->renderHttpResponseHeader("text/xml", 200);
+    this->addPageLink((const char *)pageLink, proc, ref1, ref2);
+}
 
-    /*
-    // alternatively, plain text so iphone chrome can show it
-    this->renderHttpResponseHeader("text/plain", 200);
-    w.indenting = true;
-     */
+OmWebPageItem *OmWebPages::addButton(const __FlashStringHelper *buttonName, OmWebActionProc proc, int ref1, void *ref2)
+{
+    return this->addButton((const char *)buttonName, proc, ref1, ref2);
+}
 
-    long long now;
-#ifndef NOT_ARDUINO
-    now= millis();
-#else
-    now = 101;
+OmWebPageItem *OmWebPages::addSlider(const __FlashStringHelper *sliderName, OmWebActionProc proc, int value, int ref1, void *ref2)
+{
+    return this->addSlider((const char *)sliderName, proc, value, ref1, ref2);
+}
+
+OmWebPageItem *OmWebPages::addSlider(int rangeLow, int rangeHigh, const __FlashStringHelper *sliderName, OmWebActionProc proc, int value, int ref1, void *ref2)
+{
+    return this->addSlider(rangeLow, rangeHigh, (const char *)sliderName, proc, value, ref1, ref2);
+}
+
+OmWebPageItem *OmWebPages::addTime(const __FlashStringHelper *itemName, OmWebActionProc proc, int value, int ref1, void *ref2)
+{
+    return this->addTime((const char *)itemName, proc, value, ref1, ref2);
+}
+
+OmWebPageItem *OmWebPages::addColor(const __FlashStringHelper *itemName, OmWebActionProc proc, int value, int ref1, void *ref2)
+{
+    return this->addColor((const char *)itemName, proc, value, ref1, ref2);
+}
+
+OmWebPageItem *OmWebPages::addSelect(const __FlashStringHelper *itemName, OmWebActionProc proc, int value, int ref1, void *ref2)
+{
+    return this->addSelect((const char *)itemName, proc, value, ref1, ref2);
+}
+
+void OmWebPages::addSelectOption(const __FlashStringHelper *optionName, int optionValue)
+{
+    this->addSelectOption((const char *)optionName, optionValue);
+}
+
+OmWebPageItem *OmWebPages::addCheckbox(const __FlashStringHelper *itemName, const __FlashStringHelper *checkboxName, OmWebActionProc proc, int value, int ref1, void *ref2)
+{
+    return this->addCheckbox((const char *)itemName, (const char *)checkboxName, proc, value, ref1, ref2);
+}
+
+void OmWebPages::addCheckboxX(const __FlashStringHelper *checkboxName, int value)
+{
+    this->addCheckboxX((const char *)checkboxName, value);
+}
+
+void OmWebPages::addStaticHtml(const __FlashStringHelper *staticHtml)
+{
+    StaticHtmlItem *h = this->currentPage->newItem<StaticHtmlItem>();
+    h->staticHtml = (const char *)staticHtml;
+    this->currentPage->addItem(h);
+}
+
+bool OmWebPages::doAction(const char *pageName, const char *itemId)
+{
+    Page *page = this->findPage(pageName, true);
+    PageItem *item = this->findPageItem(pageName, itemId, true);
+    if(item)
+    {
+        return item->doAction(page);
+    }
+    return false;
+}
+
+/// Free heap, the biggest block of it, and how fragmented it is, 0 to 100. All 0 off the ESPs.
+static void getHeapInfo(uint32_t &freeBytes, uint32_t &maxBlock, int &fragmentation)
+{
+    freeBytes = 0;
+    maxBlock = 0;
+    fragmentation = 0;
+#ifdef ARDUINO_ARCH_ESP8266
+    freeBytes = ESP.getFreeHeap();
+    maxBlock = ESP.getMaxFreeBlockSize();
+    fragmentation = ESP.getHeapFragmentation();
+#endif
+#ifdef ARDUINO_ARCH_ESP32
+    freeBytes = ESP.getFreeHeap();
+    maxBlock = ESP.getMaxAllocHeap();
+    if(freeBytes)
+        fragmentation = 100 - (int)((uint64_t)maxBlock * 100 / freeBytes);
 #endif
+}
+
+static void renderStatusField(StatusWriter &w, int ix)
+{
+    w.beginRecord("field");
+    w.add("ix", ix);
+    const char *fieldName = OmEeprom.getFieldName(ix);
+    w.add("name", fieldName);
+    w.add("length", OmEeprom.getFieldLength(ix));
+    int fieldType = OmEeprom.getFieldType(ix);
+    w.add("type", fieldType);
+    // TODO could have flags for dont show, like wifi password i guess 2020
+    if(fieldType == OME_TYPE_STRING)
+        w.add("value", OmEeprom.getString(fieldName).c_str());
+    else if(fieldType == OME_TYPE_INT)
+        w.add("value", OmEeprom.getInt(fieldName));
+    w.endRecord();
+}
+
+static void renderStatusItem(StatusWriter &w, OmRequestInfo *ri, Page *page, PageItem *pageItem)
+{
+    w.beginRecord("item");
+    w.addF("ctl", "http://%s:%d/_control?page=%s&item=%s&value=xxx",
+           omIpToString(ri->serverIp),
+           ri->serverPort,
+           page->id,
+           pageItem->id);
+    w.add("name", pageItem->name);
+    w.add("id", pageItem->id);
+    w.add("pageId", page->id);
+    w.add("value", pageItem->value);
+    w.add("ref1", pageItem->ref1);
+    w.addF("ref2", "0x%08x", pageItem->ref2);
+    pageItem->renderStatusey(w);
+    w.endRecord();
+}
+
+static void renderStatusPage(StatusWriter &w, Page *page)
+{
+    w.beginRecord("page");
+    w.add("name", page->name);
+    w.add("id", page->id);
+    w.add("k", page->items.size());
+    w.endRecord();
+}
+
+void OmWebPages::renderStatusXml(OmXmlWriter &w, bool asText)
+{
+    this->renderHttpResponseHeader(asText ? "text/plain" : "text/xml", 200);
+
+    /*
+    // alternatively, plain text so iphone chrome can show it
+    this->renderHttpResponseHeader("text/plain", 200);
+    w.indenting = true;
+     */
+
+    XmlStatusWriter sw(w);
+    this->renderStatus(sw);
+}
+
+void OmWebPages::renderStatusXmlSince(OmXmlWriter &w, bool asText, uint32_t since)
+{
+    this->renderHttpResponseHeader(asText ? "text/plain" : "text/xml", 200);
+    XmlStatusWriter sw(w);
+    this->renderStatusSince(sw, since);
+}
+
+void OmWebPages::renderStatusJson(OmXmlWriter &w, bool asText)
+{
+    this->renderHttpResponseHeader(asText ? "text/plain" : "application/json", 200);
+    JsonStatusWriter sw(&w);
+    this->renderStatus(sw);
+}
+
+void OmWebPages::renderStatusJsonSince(OmXmlWriter &w, bool asText, uint32_t since)
+{
+    this->renderHttpResponseHeader(asText ? "text/plain" : "application/json", 200);
+    JsonStatusWriter sw(&w);
+    this->renderStatusSince(sw, since);
+}
 
-    w.beginElement("xml");
-    w.addAttribute("poweredBy", "OmEspHelpers");
-    w.beginElement("status");
-    w.addAttribute("uptime", omTime(now));
-    w.addAttribute("millis", now);
+void OmWebPages::renderStatus(StatusWriter &w)
+{
+    long long now;
+#ifndef NOT_ARDUINO
+    now= millis();
+#else
+    now = 101;
+#endif
 
-    w.addAttributeF("requests","%d", this->requestsAll);
-    w.addAttributeF("maxHtml", "%d", this->greatestRenderLength);
+    w.beginRecord("xml");
+    w.add("poweredBy", "OmEspHelpers");
+    w.beginRecord("status");
+    w.add("uptime", omTime(now));
+    w.add("millis", now);
+
+    w.add("requests", this->requestsAll);
+    w.add("maxHtml", this->greatestRenderLength);
+    w.add("maxHtmlUnminified", this->greatestRenderLengthUnminified);
+    w.add("changes", omChangeSerial()); // for "_status?since=" next time
+
+    {
+        uint32_t freeBytes, maxBlock;
+        int fragmentation;
+        getHeapInfo(freeBytes, maxBlock, fragmentation);
+        w.add("heapFree", freeBytes);
+        w.add("heapFreeLowest", this->heapFreeLowest);
+        w.add("heapMaxBlock", maxBlock);
+        w.add("heapFragmentation", fragmentation);
+
+        // the arenas pages are built in: heap they hold, what's in use now, and the most ever
+        size_t arenaReserved = this->siteArena.reserved;
+        size_t arenaUsed = this->siteArena.used;
+        size_t arenaHighWater = this->siteArena.highWater;
+        for(Page *page : this->pages)
+        {
+            arenaReserved += page->arena.reserved;
+            arenaUsed += page->arena.used;
+            arenaHighWater += page->arena.highWater;
+        }
+        w.add("arenaReserved", (long long)arenaReserved);
+        w.add("arenaUsed", (long long)arenaUsed);
+        w.add("arenaHighWater", (long long)arenaHighWater);
+    }
 
 #ifdef NOT_ARDUINO
     // mac stubs for testing
-    w.addAttributeF("serverIp", "localhost:5555");
-    w.addAttributeF("bonjour", "--bonjour for this mac--");
+    w.add("serverIp", "localhost:5555");
+    w.add("bonjour", "--bonjour for this mac--");
 #else
     if(this->ri)
     {
-        w.addAttributeF("clientIp", "%s:%d", omIpToString(ri->clientIp, true), ri->clientPort);
-        w.addAttributeF("serverIp", "%s:%d",
-                      omIpToString(ri->serverIp), ri->serverPort);
-        String bonjourName = ri->bonjourName;
+        w.addF("clientIp", "%s:%d", omIpToString(ri->clientIp, true), ri->clientPort);
+        w.addF("serverIp", "%s:%d",
+               omIpToString(ri->serverIp), ri->serverPort);
         if(ri->bonjourName && ri->bonjourName[0])
-            w.addAttributeF("bonjour", "%s", ri->bonjourName, ri->bonjourName);
+            w.add("bonjour", ri->bonjourName);
         if(ri->ap && ri->ap[0])
-            w.addAttributeF(    "accessPoint", "%s", ri->ap);
+            w.add("accessPoint", ri->ap);
         else
-            w.addAttributeF(    "wifiNetwork", "%s", ri->ssid);
+            w.add("wifiNetwork", ri->ssid);
     }
 #endif
-    w.addAttributeF("built", "%s %s", this->__date__, this->__time__);
+    w.addF("built", "%s %s", this->__date__, this->__time__);
     if(this->__file__)
-        w.addAttributeF("file", "%s", this->__file__);
+        w.add("file", this->__file__);
 #ifdef ARDUINO_BOARD
-    w.addAttributeF("board", "%s", ARDUINO_BOARD);
+    w.add("board", ARDUINO_BOARD);
 #endif
 
 #ifndef NOT_ARDUINO
     {
-        w.beginAttribute("udp");
+        w.beginValue("udp");
         OmUdp *u = OmUdp::first;
         int k = 0;
         while(u && k < 20)
         {
             if(k)
-                w.putf(",%d", u->portNumber);
+                w.putF(",%d", u->portNumber);
             else
-                w.putf("%d", u->portNumber);
+                w.putF("%d", u->portNumber);
             k++;
             u = u->next;
         }
-        w.endAttribute();
+        w.endValue();
     }
 #endif
 
-    w.endElement("status");
+    w.endRecord(); // status
 
     if(OmEepromClass::active)
     {
-        w.beginElement("eeprom");
-        w.addAttribute("dataSize", OmEeprom.getDataSize());
+        w.beginRecord("eeprom");
+        w.add("dataSize", OmEeprom.getDataSize());
         int k = OmEeprom.getFieldCount();
-        w.addAttribute("fieldCount", k);
+        w.add("fieldCount", k);
+        w.beginList("fields");
         for(int ix = 0; ix < k; ix++)
-        {
-            w.beginElement("field");
-            w.addAttribute("ix", ix);
-            const char *fieldName = OmEeprom.getFieldName(ix);
-            w.addAttribute("name", fieldName);
-            w.addAttribute("length", OmEeprom.getFieldLength(ix));
-            int fieldType = OmEeprom.getFieldType(ix);
-            w.addAttribute("type", fieldType);
-            // TODO could have flags for dont show, like wifi password i guess 2020
-            if(fieldType == OME_TYPE_STRING)
-                w.addAttribute("value", OmEeprom.getString(fieldName).c_str());
-            else if(fieldType == OME_TYPE_INT)
-                w.addAttribute("value", OmEeprom.getInt(fieldName));
-            w.endElement();
-        }
-        w.endElement();
+            renderStatusField(w, ix);
+        w.endList();
+        w.endRecord();
     }
 
+    w.beginList("pages");
     for(auto page : this->pages)
-    {
-        w.beginElement("page");
-        w.addAttribute("name", page->name);
-        w.addAttribute("id", page->id);
-        w.addAttribute("k", page->items.size());
-        w.endElement("page");
-    }
+        renderStatusPage(w, page);
+    w.endList();
 
+    w.beginList("urlHandlers");
     for (auto urlHandler : this->urlHandlers)
     {
-        w.beginElement("urlHandler");
-        w.addAttribute("url", urlHandler->url);
-        w.addAttribute("ref1", urlHandler->ref1);
-        w.addAttributeF("ref2", "0x%08x", urlHandler->ref2);
-        w.addAttributeF("proc", "0x%08x", urlHandler->handlerProc);
-        w.endElement("urlHandler");
+        w.beginRecord("urlHandler");
+        w.add("url", urlHandler->url);
+        w.add("ref1", urlHandler->ref1);
+        w.addF("ref2", "0x%08x", urlHandler->ref2);
+        w.addF("proc", "0x%08x", urlHandler->handlerProc);
+        w.endRecord();
     }
+    w.endList();
+
+    w.beginList("items");
+    for(auto page : this->pages)
+        for(auto pageItem : page->items)
+            renderStatusItem(w, this->ri, page, pageItem);
+    w.endList();
+
+    w.endRecord(); // xml
+}
+
+/// Just what changed after since: pages whose layout changed, and their items
+/// in full, as in the whole status; values of items on other pages; and eeprom
+/// fields. "changes" is where to pick up next time. Nothing new is a few dozen bytes.
+void OmWebPages::renderStatusSince(StatusWriter &w, uint32_t since)
+{
+    w.beginRecord("xml");
+    w.add("since", since);
+    w.add("changes", omChangeSerial());
+
+    w.beginList("pages");
+    for(auto page : this->pages)
+        if(page->layoutSerial > since)
+            renderStatusPage(w, page);
+    w.endList();
 
+    w.beginList("items");
     for(auto page : this->pages)
+    {
         for(auto pageItem : page->items)
         {
-            w.beginElement("item");
-            w.addAttributeF("ctl", "http://%s:%d/_control?page=%s&item=%s&value=xxx",
-                            omIpToString(ri->serverIp),
-                            ri->serverPort,
-                            page->id,
-                            pageItem->id);
-            w.addAttribute("name", pageItem->name);
-            w.addAttribute("id", pageItem->id);
-            w.addAttribute("pageId", page->id);
-            w.addAttribute("value", pageItem->value);
-            w.addAttribute("ref1", pageItem->ref1);
-            w.addAttributeF("ref2", "0x%08x", pageItem->ref2);
-            pageItem->renderStatusey(w);
-            w.endElement("item");
+            if(page->layoutSerial > since)
+                renderStatusItem(w, this->ri, page, pageItem);
+            else if(pageItem->valueSerial > since)
+            {
+                w.beginRecord("item");
+                w.add("id", pageItem->id);
+                w.add("pageId", page->id);
+                w.add("value", pageItem->value);
+                w.endRecord();
+            }
         }
+    }
+    w.endList();
+
+    if(OmEepromClass::active)
+    {
+        w.beginList("fields");
+        int k = OmEeprom.getFieldCount();
+        for(int ix = 0; ix < k; ix++)
+            if(OmEeprom.getFieldChangeSerial(ix) > since)
+                renderStatusField(w, ix);
+        w.endList();
+    }
 
-    w.endElement("xml");
+    w.endRecord(); // xml
 }
 
 void OmWebPages::renderInfo(OmXmlWriter &w)
@@ -1131,7 +2036,7 @@ void OmWebPages::renderInfo(OmXmlWriter &w)
 #endif
     }
     w.addContentF("requests:    %d\n", this->requestsAll);
-    w.addContentF("maxHtml:     %d\n", this->greatestRenderLength);
+    w.addContentF("maxHtml:     %d (%d unminified)\n", this->greatestRenderLength, this->greatestRenderLengthUnminified);
 
 #ifndef NOT_ARDUINO
     w.addContentF("uptime:      %s\n", omTime(now));
@@ -1144,6 +2049,8 @@ void OmWebPages::renderInfo(OmXmlWriter &w)
     w.addContentF("freeBytes:   %d\n", esp_get_free_heap_size());
 #endif
 
+    w.addContentF("ramSaved:    %d (strings in flash)\n", this->flashStringBytes());
+
 #ifdef ARDUINO_BOARD
     w.addContentF("board:       %s\n", ARDUINO_BOARD);
 #endif
@@ -1227,6 +2134,162 @@ void OmWebPages::renderInfo(OmXmlWriter &w)
     w.endElement();
 }
 
+/// The route's numbers, making room for it the first time. Past OMWP_PERF_ROUTES, "(other)".
+PerfRoute *OmWebPages::findPerfRoute(const char *route)
+{
+    if(OMWP_PERF_ROUTES <= 0)
+        return NULL;
+    PerfRoute *last = NULL;
+    for(int pass = 0; pass < 2; pass++)
+    {
+        for(PerfRoute *r = this->perfRoutes; r; r = r->next)
+        {
+            if(r->route == route || omStringEqual(r->route, route))
+                return r;
+            last = r;
+        }
+        if(this->perfRouteCount < OMWP_PERF_ROUTES - 1)
+            break;
+        route = "(other)";
+    }
+    PerfRoute *r = new(this->siteArena.alloc(sizeof(PerfRoute))) PerfRoute();
+    r->route = route;
+    if(last)
+        last->next = r;
+    else
+        this->perfRoutes = r;
+    this->perfRouteCount++;
+    return r;
+}
+
+void OmWebPages::perfRecord(const char *route, uint32_t parseTicks, uint32_t renderTicks, unsigned int bytes, bool error)
+{
+    PerfRoute *r = this->findPerfRoute(route);
+    this->perfLast = r;
+    if(!r)
+        return;
+    r->requests++;
+    if(error)
+        r->errors++;
+    r->parseMicros.add(omTicksToMicros(parseTicks));
+    r->renderMicros.add(omTicksToMicros(renderTicks));
+    r->bytes.add(bytes);
+}
+
+void OmWebPages::requestFinished(uint32_t stallTicks, bool ok)
+{
+    PerfRoute *r = this->perfLast;
+    this->perfLast = NULL;
+    if(!r)
+        return;
+    r->stallMicros.add(omTicksToMicros(stallTicks));
+    if(!ok)
+        r->errors++;
+}
+
+void OmWebPages::resetPerf()
+{
+    for(PerfRoute *r = this->perfRoutes; r; r = r->next)
+        r->reset();
+#ifndef NOT_ARDUINO
+    this->perfResetMillis = millis();
+#else
+    this->perfResetMillis = 0;
+#endif
+}
+
+static void renderPerfHistogramText(OmXmlWriter &w, const char *name, PerfHistogram &h)
+{
+    w.addContentF("    %-8s avg %-8d max %-8d", name, (int)h.average(), (int)h.max);
+    for(int k = 0; k < PerfHistogram::kBuckets; k++)
+        if(h.buckets[k])
+            w.addContentF(" %d:%d", (int)PerfHistogram::bucketStart(k), (int)h.buckets[k]);
+    w.addContent("\n");
+}
+
+static void renderPerfHistogramJson(OmJsonWriter &j, const char *key, PerfHistogram &h)
+{
+    j.beginObject(key);
+    j.addInt("count", h.count);
+    j.addInt("average", h.average());
+    j.addInt("max", h.max);
+    j.beginArray("buckets");
+    for(int k = 0; k < PerfHistogram::kBuckets; k++)
+        j.addInt(NULL, h.buckets[k]);
+    j.endArray();
+    j.endObject();
+}
+
+void OmWebPages::renderPerf(OmXmlWriter &w, bool asJson)
+{
+    long long now;
+#ifndef NOT_ARDUINO
+    now = millis();
+#else
+    now = 101;
+#endif
+
+    // busiest first
+    PerfRoute *routes[OMWP_PERF_ROUTES + 1];
+    int routeCount = 0;
+    for(PerfRoute *r = this->perfRoutes; r && routeCount < OMWP_PERF_ROUTES; r = r->next)
+    {
+        int ix = routeCount++;
+        while(ix > 0 && routes[ix - 1]->busyMicros() < r->busyMicros())
+        {
+            routes[ix] = routes[ix - 1];
+            ix--;
+        }
+        routes[ix] = r;
+    }
+
+    if(asJson)
+    {
+        this->renderHttpResponseHeader("application/json", 200);
+        OmJsonWriter j(&w);
+        j.beginObject();
+        j.addInt("uptimeMillis", now);
+        j.addInt("periodMillis", now - this->perfResetMillis);
+        j.beginArray("bucketStarts");
+        for(int k = 0; k < PerfHistogram::kBuckets; k++)
+            j.addInt(NULL, PerfHistogram::bucketStart(k));
+        j.endArray();
+        j.beginArray("routes");
+        for(int ix = 0; ix < routeCount; ix++)
+        {
+            PerfRoute *r = routes[ix];
+            j.beginObject();
+            j.addString("route", r->route);
+            j.addInt("requests", r->requests);
+            j.addInt("errors", r->errors);
+            j.addInt("busyMicros", r->busyMicros());
+            renderPerfHistogramJson(j, "parseMicros", r->parseMicros);
+            renderPerfHistogramJson(j, "renderMicros", r->renderMicros);
+            renderPerfHistogramJson(j, "bytes", r->bytes);
+            renderPerfHistogramJson(j, "stallMicros", r->stallMicros);
+            j.endObject();
+        }
+        j.endAll();
+        return;
+    }
+
+    this->renderHttpResponseHeader("text/plain", 200);
+    w.addContentF("requests by route, busiest first, over the last %s\n", omTime(now - this->perfResetMillis));
+    w.addContent("times in microseconds; histograms are bucket start:count, in powers of 4\n");
+    for(int ix = 0; ix < routeCount; ix++)
+    {
+        PerfRoute *r = routes[ix];
+        if(!r->requests)
+            continue; // not since the reset
+        w.addContentF("\n/%s  requests: %d  errors: %d  busy: %lld\n", omRam(r->route),
+                      (int)r->requests, (int)r->errors, (long long int)r->busyMicros());
+        renderPerfHistogramText(w, "parse", r->parseMicros);
+        renderPerfHistogramText(w, "render", r->renderMicros);
+        renderPerfHistogramText(w, "bytes", r->bytes);
+        renderPerfHistogramText(w, "stall", r->stallMicros);
+    }
+}
+
 void OmWebPages::renderDefaultFooter(OmXmlWriter &w)
 {
     w.addElement("hr");
@@ -1237,17 +2300,8 @@ void OmWebPages::renderDefaultFooter(OmXmlWriter &w)
     }
 }
 
-const char *colorItem = "#e0e0e0";
-const char *colorHover = "#e0ffe0";
-const char *colorButtonPress = "#707070";
-
-void OmWebPages::renderStyle(OmXmlWriter &w, int bgColor)
-{
-    w.beginElement("style");
-    w.addContent("*{font-family:arial}\n");
-    // http://jkorpela.fi/forms/extraspace.html suggests margin:0 for forms to remove strange extra verticals.
-    // https://stackoverflow.com/questions/4137255/checkboxes-in-web-pages-how-to-make-them-bigger for the big checkboxes
-    w.addContent(R"JS(
+// The biggest constant parts of the style and script, in flash, so they don't take RAM.
+static const char omStyleMain[] PROGMEM = R"JS(
                  pre, pre a, .t {font-size:23px;font-family:Courier, monospace; word-wrap:break-word; overflow:auto; color:black}
                  form {margin-bottom:0px}
                  a:link { text-decoration: none;}
@@ -1270,63 +2324,14 @@ void OmWebPages::renderStyle(OmXmlWriter &w, int bgColor)
                  input[type='checkbox']:checked {
                  background: #abd;
                  }
-                 )JS"
-    );
-
-
-//    calc(var(--width) / 10)
+                 )JS";
 
-//    calc(var(--parentWidth) - 90px)
-
-
-    // dvb2021-08-09 pardon these experiments with trying to size the button predictable smaller than its container, for nested groups.
-//        w.addContentF(".box1,.box2,.button{font-size:30px; width: 90%% ; margin:10px; "
-    w.addContentF(".box1,.box2,.button{font-size:30px; width:420px ; margin:10px; "
-//    w.addContentF(".box1,.box2,.button{font-size:30px; width:calc(100%%-150px) ; margin:10px; "
-                 "padding:10px ; background:%s;"
-                 "border-top-left-radius:15px;"
-                 "border-bottom-right-radius:15px;"
-                 "-webkit-user-select:none;"  // disable the touch-and-hold selection, it interferes with button pressing.
-                 "}\n"
-                 , colorItem
-                 );
-    // Not sure why I need to add more width to the button, to make it match
-//    w.addContent(".button{border:2px solid black;width:440px;display:block}\n");
-    w.addContent(".button{border:2px solid black;width:calc(100% - 30px);display:block}\n");
-    w.addContent(".box2{display:inline-block;"
-                 "font-size:22px; padding:7px;"
-                 "width:auto;overflow:hidden ; "
-                 "margin-right:0px;margin-top:0px}\n"); // no right margin, so they space nicely in a row
-    w.addContentF(".box1:hover,.box2:hover{background:%s;}\n", colorHover);
-    w.addContent("body{width:470px;padding:5px;margin:0px;margin-top:5px}\n");
-    
-    // slider styling, from http://brennaobrien.com/blog/2014/05/style-input-type-range-in-every-browser.html
-    
-    w.addContent(
+static const char omStyleSlider[] PROGMEM =
                  "input[type=range] { -webkit-appearance: none; border: 0px; } \n"
                  "input[type=range]::-webkit-slider-runnable-track { height: 5px; background: #663; border: none; border-radius: 3px; } \n"
-                 "input[type=range]::-webkit-slider-thumb { -webkit-appearance: none; border: none; height: 50px; width: 50px; border-radius: 10%; background: goldenrod; margin-top: -22px; } \n"
-                 );
-
-    w.addContentF("body { background-color: #%06x }", bgColor);
-    w.endElement();
-}
-
-void OmWebPages::renderScript(OmXmlWriter &w)
-{
-    w.beginElement("script");
+                 "input[type=range]::-webkit-slider-thumb { -webkit-appearance: none; border: none; height: 50px; width: 50px; border-radius: 10%; background: goldenrod; margin-top: -22px; } \n";
 
-    /*
-     * So, about live updates. Sliders and Color input types are defined to send input/oninput() events
-     * as you drag the mouse, and change/onchange() when you release/commit. Experimentally, however,
-     * I see on chrome that color picker sends oninput and onchange on every movement AND mouseup. And
-     * on firefox, the color picker sends exclusively oninput, and never onchange.
-     *
-     * So, I treat change and input the same, and the timeout performs a commit on the last received
-     * event of either type.
-     */
-    
-    w.addContent(
+static const char omScriptMain[] PROGMEM =
 R"JS(
 
     function reqListener ()
@@ -1334,9 +2339,32 @@ R"JS(
         console.log(this.responseText)
     }
 
+    // When the server offers the "_ws" websocket, control values go both ways on it,
+    // in 8 byte records: page number, item number (uint16), value (int32), little endian.
+    var controlSocket = null;
+    function sendControl(page, itemName, value)
+    {
+        var v = Number(value); // '0x' colors are fine, '12:30/1' times go by http
+        if(controlSocket && controlSocket.readyState == 1 && Number.isInteger(v))
+        {
+            var record = new DataView(new ArrayBuffer(8));
+            record.setUint16(0, parseInt(page.substring(1)), true);
+            record.setUint16(2, parseInt(itemName.substring(1)), true);
+            record.setInt32(4, v, true);
+            controlSocket.send(record.buffer);
+            return;
+        }
+        var oReq = new XMLHttpRequest();
+        oReq.addEventListener('load', reqListener);
+        oReq.open('GET', '/_control?page=' + page + '&item=' + itemName + '&value=' + value);
+        oReq.send();
+    }
+
     var itemEmbargoes = [];
+    var itemInputTimes = [];
     function doOrEmbargo(itemName, commitProc)
     {
+        itemInputTimes[itemName] = Date.now();
         // the commitProc should include the itemName, and commit the current (latest) value, and send the http update.
         if(!Boolean(itemEmbargoes[itemName]))
         {
@@ -1345,7 +2373,7 @@ R"JS(
                                                  {
                                                      itemEmbargoes[itemName] = null; // clear the embargo
                                                      commitProc();
-                                                 }, 100);
+                                                 }, controlSocket ? 20 : 100); // the websocket can take it much faster
         }
     }
                  function clearEmbargo(itemName)
@@ -1379,13 +2407,9 @@ R"JS(
 
         text.style.color = '#000000';
         text.innerHTML = slider.value;
-        var oReq = new XMLHttpRequest();
-        oReq.addEventListener('load', reqListener);
 
         var cv = '0x' + slider.value.substring(1);
-        var uu = '/_control?page=' + page + '&item=' + sliderName + '&value=' + cv;
-        oReq.open('GET', uu);
-        oReq.send();
+        sendControl(page, sliderName, cv);
     }
 
     function sliderCommit(slider, page, sliderName)
@@ -1397,10 +2421,7 @@ R"JS(
         text.style.color = '#000000';
         text.innerHTML = slider.value;
 
-        var oReq = new XMLHttpRequest();
-        oReq.addEventListener('load', reqListener);
-        oReq.open('GET', '/_control?page=' + page + '&item=' + sliderName + '&value=' + slider.value);
-        oReq.send();
+        sendControl(page, sliderName, slider.value);
     }
     function timeChange(timeInput_nope, page, timeInputName)
     {
@@ -1413,12 +2434,9 @@ R"JS(
         var s = page + '_' + timeInputName;
         var timeInput = document.getElementById(s);
         var timeCheckbox = document.getElementById(s + '_checkbox');
-        var oReq = new XMLHttpRequest();
-        oReq.addEventListener('load', reqListener);
 
         var value = timeInput.value + '/' + (timeCheckbox.checked ? '1' : '0');
-        oReq.open('GET', '/_control?page=' + page + '&item=' + timeInputName + '&value=' + value);
-        oReq.send();
+        sendControl(page, timeInputName, value);
     }
 
     function selectChange(select, page, selectName, url)
@@ -1427,10 +2445,7 @@ R"JS(
         var text = document.getElementById(textId);
         text.innerHTML = select.value; // show in the UI the int value.
 
-        var oReq = new XMLHttpRequest();
-        oReq.addEventListener('load', reqListener);
-        oReq.open('GET', '/_control?page=' + page + '&item=' + selectName + '&value=' + select.value);
-        oReq.send();
+        sendControl(page, selectName, select.value);
 
         if(url == '')
         {
@@ -1461,36 +2476,246 @@ R"JS(
         var text = document.getElementById(textId);
         text.innerHTML = value; // show in the UI the int value.
 
-        var oReq = new XMLHttpRequest();
-        oReq.addEventListener('load', reqListener);
-        oReq.open('GET', '/_control?page=' + page + '&item=' + checkboxGroupName + '&value=' + value);
-        oReq.send();
+        sendControl(page, checkboxGroupName, value);
     }
 
-    )JS"
-    );
+    // Values pushed from the server, changed by another browser or by the sketch itself.
+    function setItemValue(page, itemName, value)
+    {
+        if(Date.now() - (itemInputTimes[itemName] || 0) < 500)
+            return; // being dragged right now, dont fight it.
+        var s = page + '_' + itemName;
+        var input = document.getElementById(s);
+        var text = document.getElementById(s + '_value');
+        if(input && input.type == 'color')
+        {
+            input.value = '#' + ('00000' + value.toString(16)).slice(-6);
+            if(text)
+                text.innerHTML = input.value;
+            return;
+        }
+        if(input && input.type == 'time')
+        {
+            var minutes = value & 2047;
+            input.value = ('0' + Math.floor(minutes / 60)).slice(-2) + ':' + ('0' + minutes % 60).slice(-2);
+            document.getElementById(s + '_checkbox').checked = (value & 0x8000) != 0;
+            return;
+        }
+        if(input)
+            input.value = value; // slider or select
+        for(var ix = 0, aCheckbox; (aCheckbox = document.getElementById(s + '_checkbox_' + ix)); ix++)
+            aCheckbox.checked = (value & (1 << ix)) != 0;
+        if(text)
+        {
+            text.style.color = '#000000';
+            text.innerHTML = value;
+        }
+    }
 
+    var valueSince = 0;
+    function listenForEvents()
+    {
+        if(!window.EventSource)
+            return;
+        var valueEvents = new EventSource('/_events?since=' + valueSince);
+        valueEvents.addEventListener('value', function(e)
+                                     {
+                                         var v = JSON.parse(e.data);
+                                         setItemValue(v.page, v.item, v.value);
+                                     });
+    }
 
-                 /*
-                  * Getting the momentary button to work was tricky.
-                  * On desktop, mousedown/up are fine. But on mobile
-                  * Safari, they are both issued on finger-up from the button.
-                  * So we use touchstart/end also, and disable mousedown/up
-                  * if we see touch events. (So we dont get both pairs.)
-                  */
-    w.addContentF(
-  R"JS(
-  var quellMouse = 0;
-  function button(button, page, buttonName, v, url)
-  {
-      if(v>=2)quellMouse=1;  // ignore mouses after first touch event
-      if(quellMouse&&v<2)return; // ignore the mouse.
-      v&=1; // mousedown/up is 1,0 and touchstart/end is 3,2
+    function listenOnSocket()
+    {
+        if(!window.WebSocket)
+            return listenForEvents();
+        var opened = false;
+        var ws = new WebSocket((location.protocol == 'https:' ? 'wss://' : 'ws://') + location.host + '/_ws?since=' + valueSince);
+        ws.binaryType = 'arraybuffer';
+        ws.onopen = function()
+        {
+            opened = true;
+            controlSocket = ws;
+        };
+        ws.onmessage = function(e)
+        {
+            var records = new DataView(e.data);
+            for(var ix = 0; ix + 8 <= records.byteLength; ix += 8)
+            {
+                var page = records.getUint16(ix, true);
+                var item = records.getUint16(ix + 2, true);
+                if(page == 0xffff)
+                    valueSince = records.getUint32(ix + 4, true);
+                else
+                    setItemValue('p' + page, 'i' + item, records.getInt32(ix + 4, true));
+            }
+        };
+        ws.onclose = function()
+        {
+            controlSocket = null;
+            if(opened)
+                setTimeout(listenOnSocket, 3000);
+            else
+                listenForEvents(); // no websocket on this server, the event stream will do.
+        };
+    }
+
+    document.addEventListener('DOMContentLoaded', function()
+    {
+        var since = document.body.getAttribute('data-values');
+        if(since == null)
+            return;
+        valueSince = since;
+        if(document.body.hasAttribute('data-ws'))
+            listenOnSocket();
+        else
+            listenForEvents();
+    });
+
+    )JS";
+
+const char *colorItem = "#e0e0e0";
+const char *colorHover = "#e0ffe0";
+const char *colorButtonPress = "#707070";
+
+/// Bytes of strings kept in flash that would otherwise take RAM: the builtin
+/// style and script, and names and labels given as F("...") or PSTR("...").
+int OmWebPages::flashStringBytes()
+{
+    int result = flashBytes(omStyleMain) + flashBytes(omStyleSlider) + flashBytes(omScriptMain);
+    for(Page *page : this->pages)
+    {
+        result += flashBytes(page->name);
+        for(PageItem *item : page->items)
+            result += item->flashBytes();
+    }
+    int fieldCount = OmEepromClass::active ? OmEeprom.getFieldCount() : 0;
+    for(int ix = 0; ix < fieldCount; ix++)
+        result += flashBytes(OmEeprom.findField(ix)->label);
+    return result;
+}
+
+/// A builtin file, as tools/makeAssetsGz.py left it in OmWebPagesAssets.h: gzipped,
+/// and minified both plain and gzipped, all made from the text with the ETag etag.
+struct OmWebAsset
+{
+    uint32_t etag;
+    int size; // of the text as written
+    const uint8_t *gz;
+    int gzSize;
+    const char *min;
+    const uint8_t *minGz;
+    int minGzSize;
+};
+
+static const OmWebAsset omAssetStyle = {OM_ASSET_STYLE_ETAG, OM_ASSET_STYLE_SIZE, omAssetStyleGz, sizeof(omAssetStyleGz),
+                                        omAssetStyleMin, omAssetStyleMinGz, sizeof(omAssetStyleMinGz)};
+static const OmWebAsset omAssetScript = {OM_ASSET_SCRIPT_ETAG, OM_ASSET_SCRIPT_SIZE, omAssetScriptGz, sizeof(omAssetScriptGz),
+                                         omAssetScriptMin, omAssetScriptMinGz, sizeof(omAssetScriptMinGz)};
+
+/// The text of a builtin file, minified or as written.
+static void renderAssetText(OmXmlWriter &w, void (*renderContent)(OmXmlWriter &w), const OmWebAsset &asset, bool minify)
+{
+    if(!minify)
+    {
+        renderContent(w);
+        return;
+    }
+    w.addContentRaw(asset.min);
+    w.minifiedBytes += asset.size - (int)strlen_P(asset.min);
+}
+
+void OmWebPages::renderStyle(OmXmlWriter &w, int bgColor)
+{
+    w.beginElement("style");
+    w.addContent("");
+    renderAssetText(w, OmWebPages::renderStyleContent, omAssetStyle, OMWP_MINIFY && omAssetStyle.etag == OmWebPages::styleEtag());
+    OmPrintfStream::putF(&w, "body { background-color: #%06x }", bgColor);
+    w.endElement();
+}
+
+/// The constant part of the style sheet; it's the same for every page.
+void OmWebPages::renderStyleContent(OmXmlWriter &w)
+{
+    w.addContentRaw("*{font-family:arial}\n");
+    // http://jkorpela.fi/forms/extraspace.html suggests margin:0 for forms to remove strange extra verticals.
+    // https://stackoverflow.com/questions/4137255/checkboxes-in-web-pages-how-to-make-them-bigger for the big checkboxes
+    w.addContentRaw(omStyleMain);
+
+
+//    calc(var(--width) / 10)
+
+//    calc(var(--parentWidth) - 90px)
+
+
+    // dvb2021-08-09 pardon these experiments with trying to size the button predictable smaller than its container, for nested groups.
+//        w.addContentF(".box1,.box2,.button{font-size:30px; width: 90%% ; margin:10px; "
+    OmPrintfStream::putF(&w, ".box1,.box2,.button{font-size:30px; width:420px ; margin:10px; "
+//    w.addContentF(".box1,.box2,.button{font-size:30px; width:calc(100%%-150px) ; margin:10px; "
+                 "padding:10px ; background:%s;"
+                 "border-top-left-radius:15px;"
+                 "border-bottom-right-radius:15px;"
+                 "-webkit-user-select:none;"  // disable the touch-and-hold selection, it interferes with button pressing.
+                 "}\n"
+                 , colorItem
+                 );
+    // Not sure why I need to add more width to the button, to make it match
+//    w.addContent(".button{border:2px solid black;width:440px;display:block}\n");
+    w.addContentRaw(".button{border:2px solid black;width:calc(100% - 30px);display:block}\n");
+    w.addContentRaw(".box2{display:inline-block;"
+                 "font-size:22px; padding:7px;"
+                 "width:auto;overflow:hidden ; "
+                 "margin-right:0px;margin-top:0px}\n"); // no right margin, so they space nicely in a row
+    OmPrintfStream::putF(&w, ".box1:hover,.box2:hover{background:%s;}\n", colorHover);
+    w.addContentRaw("body{width:470px;padding:5px;margin:0px;margin-top:5px}\n");
+    
+    // slider styling, from http://brennaobrien.com/blog/2014/05/style-input-type-range-in-every-browser.html
+    
+    w.addContentRaw(omStyleSlider);
+}
+
+void OmWebPages::renderScript(OmXmlWriter &w)
+{
+    w.beginElement("script");
+    w.addContent("");
+    renderAssetText(w, OmWebPages::renderScriptContent, omAssetScript, OMWP_MINIFY && omAssetScript.etag == OmWebPages::scriptEtag());
+    w.endElement();
+}
+
+/// The builtin javascript; it's the same for every page.
+void OmWebPages::renderScriptContent(OmXmlWriter &w)
+{
+
+    /*
+     * So, about live updates. Sliders and Color input types are defined to send input/oninput() events
+     * as you drag the mouse, and change/onchange() when you release/commit. Experimentally, however,
+     * I see on chrome that color picker sends oninput and onchange on every movement AND mouseup. And
+     * on firefox, the color picker sends exclusively oninput, and never onchange.
+     *
+     * So, I treat change and input the same, and the timeout performs a commit on the last received
+     * event of either type.
+     */
+    
+    w.addContentRaw(omScriptMain);
+
+
+                 /*
+                  * Getting the momentary button to work was tricky.
+                  * On desktop, mousedown/up are fine. But on mobile
+                  * Safari, they are both issued on finger-up from the button.
+                  * So we use touchstart/end also, and disable mousedown/up
+                  * if we see touch events. (So we dont get both pairs.)
+                  */
+    OmPrintfStream::putF(&w,
+  R"JS(
+  var quellMouse = 0;
+  function button(button, page, buttonName, v, url)
+  {
+      if(v>=2)quellMouse=1;  // ignore mouses after first touch event
+      if(quellMouse&&v<2)return; // ignore the mouse.
+      v&=1; // mousedown/up is 1,0 and touchstart/end is 3,2
       button.style.backgroundColor=v?'%s':'%s';
-      var oReq = new XMLHttpRequest();
-      oReq.addEventListener('load', reqListener);
-      oReq.open('GET', '/_control?page=' + page + '&item=' + buttonName + '&value=' + v);
-      oReq.send();
+      sendControl(page, buttonName, v);
       if(url == '')
           setTimeout(function(){ window.location.reload(); }, 500);
       else if(url != '_')
@@ -1502,7 +2727,120 @@ R"JS(
   )JS",
     colorButtonPress, colorItem
                  );
-    w.endElement();
+}
+
+/// Adds up the bytes streamed through it, to make an ETag for constant content.
+class OmHashStream : public OmIByteStream
+{
+public:
+    uint32_t hash = 2166136261u; // FNV-1a
+
+    bool put(uint8_t ch) override
+    {
+        this->hash = (this->hash ^ ch) * 16777619u;
+        return true;
+    }
+
+    bool putN(const uint8_t *data, size_t size) override
+    {
+        while(size-- > 0)
+            this->put(*data++);
+        return true;
+    }
+};
+
+static uint32_t hashOfContent(void (*renderContent)(OmXmlWriter &w))
+{
+    OmHashStream hs;
+    OmXmlWriter w(&hs);
+    renderContent(w);
+    return hs.hash;
+}
+
+uint32_t OmWebPages::styleEtag()
+{
+    static uint32_t etag = 0; // computed on first use, it never changes after.
+    if(!etag)
+        etag = hashOfContent(OmWebPages::renderStyleContent);
+    return etag;
+}
+
+uint32_t OmWebPages::scriptEtag()
+{
+    static uint32_t etag = 0;
+    if(!etag)
+        etag = hashOfContent(OmWebPages::renderScriptContent);
+    return etag;
+}
+
+void OmWebPages::renderConstantFile(OmXmlWriter &w, const char *contentType, uint32_t etag, void (*renderContent)(OmXmlWriter &w),
+                                    const OmWebAsset &asset, bool asWritten)
+{
+    // The gzipped and minified copies are made by tools/makeAssetsGz.py,
+    // and only used if they were made from the text we'd send now.
+    bool minify = OMWP_MINIFY && asset.etag == etag && !asWritten;
+    bool sendGz = asset.etag == etag
+        && this->ri && this->ri->acceptEncoding && strstr(this->ri->acceptEncoding, "gzip");
+    const uint8_t *gz = minify ? asset.minGz : asset.gz;
+    int gzSize = minify ? asset.minGzSize : asset.gzSize;
+
+    // Pages link to these with ?v=etag, so a new build gets a new url, and
+    // the browser can keep them as long as it likes. A browser that asks
+    // anyway with If-None-Match gets a bodiless 304.
+    char headers[160];
+    snprintf(headers, sizeof(headers),
+             "ETag: \"%08x%s%s\"\n"
+             "Cache-Control: public, max-age=31536000, immutable\n"
+             "Vary: Accept-Encoding\n"
+             "%s",
+             (unsigned int)etag, minify ? "-min" : "", sendGz ? "-gz" : "",
+             sendGz ? "Content-Encoding: gzip\n" : "");
+
+    char quotedEtag[12];
+    snprintf(quotedEtag, sizeof(quotedEtag), "\"%08x", (unsigned int)etag); // matches any encoding, minified or not
+    if(this->ri && this->ri->ifNoneMatch && strstr(this->ri->ifNoneMatch, quotedEtag))
+    {
+        this->renderHttpResponseHeader(contentType, 304, headers);
+        return;
+    }
+
+    if(!sendGz)
+    {
+        // Counting it costs a rendering, but browsers only ask once per build.
+        OmCountingStream counter;
+        OmXmlWriter cw(&counter);
+        renderAssetText(cw, renderContent, asset, minify);
+        this->renderHttpResponseHeader(contentType, 200, headers, (int)counter.count);
+        renderAssetText(w, renderContent, asset, minify);
+        return;
+    }
+
+    this->renderHttpResponseHeader(contentType, 200, headers, gzSize);
+
+    // copy out of flash a piece at a time
+    uint8_t buffer[64];
+    for(int ix = 0; ix < gzSize; ix += sizeof(buffer))
+    {
+        int k = gzSize - ix;
+        if(k > (int)sizeof(buffer))
+            k = sizeof(buffer);
+        memcpy_P(buffer, gz + ix, k);
+        w.putN(buffer, k);
+    }
+    if(minify)
+        w.minifiedBytes += asset.gzSize - asset.minGzSize;
+}
+
+void OmWebPages::renderStyleFile(OmXmlWriter &w, bool asWritten)
+{
+    this->renderConstantFile(w, "text/css", OmWebPages::styleEtag(), OmWebPages::renderStyleContent,
+                             omAssetStyle, asWritten);
+}
+
+void OmWebPages::renderScriptFile(OmXmlWriter &w, bool asWritten)
+{
+    this->renderConstantFile(w, "text/javascript", OmWebPages::scriptEtag(), OmWebPages::renderScriptContent,
+                             omAssetScript, asWritten);
 }
 
 /// Render the beginning of the page, leaving <body> element open and ready.
@@ -1513,7 +2851,8 @@ void OmWebPages::renderPageBeginning(OmXmlWriter &w, const char *pageTitle, int
 
 void OmWebPages::renderPageBeginningWithRedirect(OmXmlWriter &w, const char *redirectUrl, int redirectSeconds, const char *pageTitle, int bgColor, OmWebPages *p)
 {
-    w.addContentRaw("<!DOCTYPE html>\n");
+    w.addContentRaw("<!DOCTYPE html>");
+    w.addNewline();
     w.beginElement("html");
     w.addAttribute("lang", "en");
     w.beginElement("head");
@@ -1555,16 +2894,45 @@ void OmWebPages::renderPageBeginningWithRedirect(OmXmlWriter &w, const char *red
     else
         w.addElement("title", pageTitle);
 
-    OmWebPages::renderStyle(w, bgColor);
-    OmWebPages::renderScript(w);
+    if(OmWebPages::p)
+    {
+        // The constant style and script come from their own urls, cached by the browser.
+        // Only the page's own background color goes inline.
+        w.beginElement("link");
+        w.addAttribute("rel", "stylesheet");
+        w.addAttributeF("href", "/_om.css?v=%08x", OmWebPages::styleEtag());
+        w.endElement();
+        w.beginElement("style");
+        w.addContentF("body { background-color: #%06x }", bgColor);
+        w.endElement();
+        w.beginElement("script");
+        w.addAttributeF("src", "/_om.js?v=%08x", OmWebPages::scriptEtag());
+        w.addContent(""); // so it's <script></script>, browsers ignore <script/>
+        w.endElement();
+    }
+    else
+    {
+        OmWebPages::renderStyle(w, bgColor);
+        OmWebPages::renderScript(w);
+    }
     w.endElement();
     w.beginElement("body");
+    if(OmWebPages::p)
+    {
+        // where this page's "_events" pick up
+        if(addPageHole(NULL, PH_VALUE_SERIAL, NULL, 0))
+            w.addAttribute("data-values", PAGE_HOLE_MARK);
+        else
+            w.addAttributeF("data-values", "%u", (unsigned int)omChangeSerial());
+        if(OmWebPages::p->ri && OmWebPages::p->ri->webSocket)
+            w.addAttribute("data-ws", "1"); // else there's no "_ws" to try
+    }
 }
 
 static void renderLink(OmXmlWriter &w, const char *pageName)
 {
     w.beginElement("a");
-    w.addAttributeUrlF("href", "/%s", pageName);
+    w.addAttributeUrlF("href", "/%s", omRam(pageName));
     
     w.beginElement("div");
     w.addAttribute("class", "box1");
@@ -1585,13 +2953,13 @@ void OmWebPages::renderTopMenu(OmXmlWriter &w)
     
     for(Page *page : this->pages)
     {
-        if(page->name[0] != '_')
+        if(omRam(page->name)[0] != '_')
             renderLink(w, page->name);
     }
     w.addElement("hr");
     for(Page *page : this->pages)
     {
-        if(page->name[0] == '_')
+        if(omRam(page->name)[0] == '_')
             renderLink(w, page->name);
     }
     
@@ -1608,40 +2976,50 @@ void OmWebPages::renderPageButton(OmXmlWriter &w, const char *pageName)
 #ifndef NOT_ARDUINO
 //    httpBase = OmWebPages::httpBase;
 #endif
-    w.addAttributeUrlF("href", "%s%s", httpBase, pageName);
+    w.addAttributeUrlF("href", "%s%s", httpBase, omRam(pageName));
     w.beginElement("span", "class", "box2");
     w.addContent(pageName);
     w.endElement();
     w.endElement();
 }
 
-Page *OmWebPages::findPage(const char *pageName, bool byId)
+/// the N of a mechanical id like p23 or i7, or -1 if it isn't one.
+static int mechanicalIdIndex(const char *id, char prefix)
 {
-    Page *p = 0;
-    for(Page *page : this->pages)
+    if(!id || id[0] != prefix || id[1] < '0' || id[1] > '9')
+        return -1;
+    int result = 0;
+    for(const char *w = id + 1; *w; w++)
     {
-        const char *lookingFor = byId ? page->id : page->name;
-        if(omStringEqual(pageName, lookingFor))
-        {
-            p = page;
-            break;
-        }
+        if(*w < '0' || *w > '9' || w - id > 4)
+            return -1;
+        result = result * 10 + (*w - '0');
     }
-    return p;
+    return result;
+}
+
+Page *OmWebPages::findPage(const char *pageName, bool byId)
+{
+    if(!byId)
+        return (Page *)this->pageNames.find(pageName);
+
+    int ix = mechanicalIdIndex(pageName, 'p');
+    if(ix >= 0 && ix < (int)this->pages.size() && omStringEqual(pageName, this->pages[ix]->id))
+        return this->pages[ix];
+    return NULL;
 }
 
 PageItem *OmWebPages::findPageItem(const char *pageName, const char *itemName, bool byId)
 {
     Page *page = this->findPage(pageName, byId);
-    if(page)
-    {
-        for(PageItem *b : page->items)
-        {
-            const char *lookingFor = byId ? b->id : b->name;
-            if(omStringEqual(itemName, lookingFor))
-                return b;
-        }
-    }
+    if(!page)
+        return NULL;
+    if(!byId)
+        return page->findItem(itemName);
+
+    int ix = mechanicalIdIndex(itemName, 'i');
+    if(ix >= 0 && ix < (int)page->items.size() && omStringEqual(itemName, page->items[ix]->id))
+        return page->items[ix];
     return NULL;
 }
 
@@ -1663,11 +3041,68 @@ static int stringToIntMaybeTimeString(const char *valueS)
     return value;
 }
 
+/// set the item's value from a query string value, and do its action. false if no such item.
+bool OmWebPages::applyControl(const char *pageId, const char *itemId, const char *valueS)
+{
+    PageItem *item = this->findPageItem(pageId, itemId, true);
+    if(item)
+        item->setValue(stringToIntMaybeTimeString(valueS)); // if it's a time string, do minutes of day.
+    this->doAction(pageId, itemId);
+    return item != NULL;
+}
+
+/// The page itself, everything after the http header.
+void OmWebPages::renderPage(OmXmlWriter &w, Page *page)
+{
+    this->renderPageBeginning(w, page->name, this->bgColor, this);
+    w.addNewline();
+
+    if(this->headerProc && page->allowHeader)
+        this->headerProc(w, 0, 0);
+
+    {
+        w.beginElement("h2");
+        w.beginElement("a");
+        w.addAttributeF("href", "/%s", omRam(page->name));
+        w.addContent(page->name);
+        w.endElement();
+        w.endElement();
+        w.addNewline();
+    }
+
+#define tempTestGroupEmAll  false
+
+    if(tempTestGroupEmAll)
+    {
+        w.beginElement("div", "class", "box1");
+        w.addContent("grouped");
+    }
+    for(PageItem *b : page->items)
+    {
+        if(b->visible)
+        {
+            b->render(w, page, !tempTestGroupEmAll);
+            w.addContent("\n"); // even minified, it's the space between inline boxes, like mini links
+        }
+    }
+    if(tempTestGroupEmAll)
+        w.endElement("div");
+
+    if(this->footerProc && page->allowFooter)
+        this->footerProc(w, 0, this);
+
+    w.addNewline();
+    w.endElements();
+}
+
 bool OmWebPages::handleRequest(OmIByteStream *consumer, const char *pathAndQuery, OmRequestInfo *requestInfo)
 {
     bool result = false;
+    uint32_t startTicks = omTicks();
     OmXmlWriter w = OmXmlWriter(consumer);
+    w.setMinified(OMWP_MINIFY);
     Page *page = 0;
+    const char *perfRoute = "(no pages)"; // what "_perf" counts this request as
 
     // make our httpBase up to date
     sprintf(OmWebPages::httpBase, "http://%s:%d/",omIpToString(requestInfo->serverIp), requestInfo->serverPort);
@@ -1676,10 +3111,19 @@ bool OmWebPages::handleRequest(OmIByteStream *consumer, const char *pathAndQuery
     this->ri = requestInfo;
 
     this->requestsAll++;
+    {
+        uint32_t freeBytes, maxBlock;
+        int fragmentation;
+        getHeapInfo(freeBytes, maxBlock, fragmentation);
+        if(freeBytes && (!this->heapFreeLowest || freeBytes < this->heapFreeLowest))
+            this->heapFreeLowest = freeBytes;
+    }
     static OmWebRequest request;
     request.init(pathAndQuery);
     const char *requestPath = request.path;
     this->rq = &request; // here during the url handling callback
+    uint32_t renderTicks = omTicks();
+    uint32_t parseTicks = requestInfo->parseTicks + (renderTicks - startTicks);
 
     if(this->pages.size() == 0)
     {
@@ -1701,29 +3145,93 @@ bool OmWebPages::handleRequest(OmIByteStream *consumer, const char *pathAndQuery
         const char *pageName = request.getValue("page");
         const char *itemId = request.getValue("item");
         const char *valueS = request.getValue("value");
-        
-        bool setParam = false;
-        if(valueS)
+
+        int valueCount = 0;
+        for(int ix = 0; ix < request.getQueryCount(); ix++)
+            if(omStringEqual(request.getQueryKey(ix), "value"))
+                valueCount++;
+
+        if(valueCount > 1)
         {
-            // if it's a time string, do minutes of day.
-            int value = stringToIntMaybeTimeString(valueS);
-            PageItem *item = this->findPageItem(pageName, itemId, true);
-            if(item)
+            // A batch, like restoring a scene: page=p1&item=i3&value=7&item=i4&value=9&page=p2...
+            // Each value goes to the page and item just before it, in order, and
+            // /_control answers a line for each, or /_control.json an array entry.
+            bool isJson = omStringEqual("/_control.json", requestPath);
+            bool isControl = isJson || omStringEqual("/_control", requestPath);
+            OmJsonWriter j(&w);
+            if(isControl)
+                this->renderHttpResponseHeader(isJson ? "application/json" : "text/plain", 200);
+            if(isJson)
+                j.beginArray();
+            pageName = "";
+            itemId = "";
+            for(int ix = 0; ix < request.getQueryCount(); ix++)
+            {
+                const char *key = request.getQueryKey(ix);
+                const char *value = request.getQueryValue(ix);
+                if(omStringEqual(key, "page"))
+                    pageName = value;
+                else if(omStringEqual(key, "item"))
+                    itemId = value;
+                else if(omStringEqual(key, "value"))
+                {
+                    bool ok = this->applyControl(pageName, itemId, value);
+                    if(isJson)
+                    {
+                        j.beginObject();
+                        j.addString("page", pageName);
+                        j.addString("item", itemId);
+                        j.addBool("ok", ok);
+                        j.endObject();
+                    }
+                    else if(isControl)
+                        w.addContentF("%s %s %s\n", pageName, itemId, ok ? "ok" : "notok");
+                }
+            }
+            if(isControl)
             {
-                item->setValue(value);
-                setParam = true;
+                j.endAll();
+                perfRoute = isJson ? "_control.json" : "_control";
+                this->requestsParam++;
+                result = true;
+                goto goHome;
             }
         }
-        
-        this->doAction(pageName, itemId);
-        
-        if(omStringEqual("/_control", requestPath))
+        else
         {
-            this->requestsParam++;
-            this->renderHttpResponseHeader("text/html", 200);
-            w.addContentF("%s", setParam ? "ok" : "notok");
-            result = true;
-            goto goHome;
+            bool setParam = false;
+            if(valueS)
+                setParam = this->applyControl(pageName, itemId, valueS);
+            else
+                this->doAction(pageName, itemId);
+
+            if(omStringEqual("/_control", requestPath))
+            {
+                perfRoute = "_control";
+                this->requestsParam++;
+                this->renderHttpResponseHeader("text/html", 200);
+                w.addContentF("%s", setParam ? "ok" : "notok");
+                result = true;
+                goto goHome;
+            }
+            if(omStringEqual("/_control.json", requestPath))
+            {
+                perfRoute = "_control.json";
+                this->requestsParam++;
+                this->renderHttpResponseHeader("application/json", 200);
+                OmJsonWriter j(&w);
+                j.beginObject();
+                j.addBool("ok", setParam);
+                if(setParam)
+                {
+                    PageItem *item = this->findPageItem(pageName, itemId, true);
+                    if(item)
+                        j.addInt("value", item->value);
+                }
+                j.endObject();
+                result = true;
+                goto goHome;
+            }
         }
     }
     
@@ -1738,28 +3246,29 @@ bool OmWebPages::handleRequest(OmIByteStream *consumer, const char *pathAndQuery
     // Take a pocket-universe detour to maybe do a plain old URL handler.
     if(!page)
     {
-        for(UrlHandler *uh : this->urlHandlers)
+        UrlHandler *uh = (UrlHandler *)this->urlHandlerPaths.find(requestPath);
+        if(uh)
         {
-            if(omStringEqual(requestPath, uh->url))
-            {
-                // found a handler.
-                // Handler must do their own http response header.
-                uh->handlerProc(w, request, uh->ref1, uh->ref2);
-                result = true;
-                goto goHome;
-            }
+            // found a handler.
+            // Handler must do their own http response header.
+            perfRoute = uh->url;
+            uh->handlerProc(w, request, uh->ref1, uh->ref2);
+            result = true;
+            goto goHome;
         }
     }
 
     if(!page && this->urlHandler.handlerProc)
     {
         // oh we have a global url handler, ok.
+        perfRoute = "(urlHandler)";
         this->urlHandler.handlerProc(w, request, urlHandler.ref1, urlHandler.ref2);
         goto goHome;
     }
 
     if(!page)
         page = this->homePage;
+    perfRoute = page->name;
 
     // +-----------------------------------
     // | Page Rendering Happens Now.
@@ -1768,60 +3277,43 @@ bool OmWebPages::handleRequest(OmIByteStream *consumer, const char *pathAndQuery
     // | in fact build the page "just in time".
 
     if(page->arrivalAction)
-        page->arrivalAction(page->name, NULL, 0, page->arrivalActionRef1, page->arrivalActionRef2);
+        callActionProc(page->arrivalAction, page->name, NULL, 0, page->arrivalActionRef1, page->arrivalActionRef2);
 
-    // Do a page, starting with the response headers.
-    this->renderHttpResponseHeader("text/html", 200);
-    this->renderPageBeginning(w, page->name, this->bgColor, this);
-    w.addContent("\n");
-    
-    if(this->headerProc && page->allowHeader)
-        this->headerProc(w, 0, 0);
-    
+    if(this->isPageCacheable(page))
     {
-        w.beginElement("h2");
-        w.beginElement("a");
-        w.addAttributeF("href", "/%s", page->name);
-        w.addContent(page->name);
-        w.endElement();
-        w.endElement();
-        w.addContent("\n");
+        this->renderCacheablePage(w, page);
     }
-
-#define tempTestGroupEmAll  false
-
-    if(tempTestGroupEmAll)
-    {
-        w.beginElement("div", "class", "box1");
-        w.addContent("grouped");
-    }
-    for(PageItem *b : page->items)
+    else
     {
-        if(b->visible)
+        // Do a page, starting with the response headers. If it'll come out
+        // the same twice, count it first, for the Content-Length. That's only
+        // worth a second rendering if the connection stays open after.
+        int contentLength = -1;
+        if(requestInfo->keepAlive && this->isPageRepeatable(page))
         {
-            b->render(w, page, !tempTestGroupEmAll);
-            w.addContent("\n");
+            OmCountingStream counter;
+            OmXmlWriter cw(&counter);
+            cw.setMinified(w.minified);
+            this->renderPage(cw, page);
+            if(!cw.getErrorCount())
+                contentLength = (int)counter.count;
         }
+        this->renderHttpResponseHeader("text/html", 200, NULL, contentLength);
+        this->renderPage(w, page);
     }
-    if(tempTestGroupEmAll)
-        w.endElement("div");
-
-    if(this->footerProc && page->allowFooter)
-        this->footerProc(w, 0, this);
-    
-    w.addContent("\n");
-    w.endElements();
     result = true;
-    
 
 goHome:
     if(w.getByteCount() > this->greatestRenderLength)
         this->greatestRenderLength = w.getByteCount();
+    if(w.getByteCount() + w.minifiedBytes > this->greatestRenderLengthUnminified)
+        this->greatestRenderLengthUnminified = w.getByteCount() + w.minifiedBytes;
     if(w.getErrorCount())
     {
         // TODO: consider showing the partial page anyways? dvb2019
         w.addContent("\n\nerror generating page\n\n");
     }
+    this->perfRecord(perfRoute, parseTicks, omTicks() - renderTicks, w.getByteCount(), w.getErrorCount() != 0);
     this->ri = 0;
     this->wp = 0;
     return result;
@@ -1830,11 +3322,120 @@ goHome:
 void OmWebPages::setBgColor(int bgColor)
 {
     this->bgColor = bgColor;
+    this->siteVersion++;
+}
+
+void OmWebPages::setPageCacheBudget(int bytes)
+{
+    this->pageCache->setBudget(bytes);
+}
+
+/// Pages made only of the builtin controls render the same until something changes them.
+bool OmWebPages::isPageRepeatable(Page *page)
+{
+    if(page->dynamicItems)
+        return false;
+    if(this->headerProc && page->allowHeader)
+        return false;
+    if(this->footerProc && page->allowFooter && this->footerProc != defaultFooterHtmlProc)
+        return false;
+    return true;
+}
+
+/// A page with an arrival action is likely rebuilt by it each time, and its template would be too.
+bool OmWebPages::isPageCacheable(Page *page)
+{
+    return this->pageCache->budget > 0 && !page->arrivalAction && this->isPageRepeatable(page);
+}
+
+/// Names the page as it would render at the given page version. Besides the versions,
+/// the server address and bonjour name show up in the page, so they're in it too.
+uint32_t OmWebPages::pageStamp(Page *page, uint32_t version)
+{
+    char s[48];
+    sprintf(s, "%x.%x.%x.%s%s", this->pageEtagNonce, version, this->siteVersion, page->id,
+            this->ri && this->ri->webSocket ? ".ws" : "");
+    uint32_t etag = omHashString(s) ^ omHashString(OmWebPages::httpBase);
+    if(this->ri && this->ri->bonjourName)
+        etag ^= omHashString(this->ri->bonjourName) * 31;
+    return etag;
+}
+
+/// A page that hasn't changed since it was last sent gets the same ETag, and a 304
+/// if the browser still has it. Otherwise it's spliced together from the page's
+/// template and the current values, compiling the template first if need be.
+void OmWebPages::renderCacheablePage(OmXmlWriter &w, Page *page)
+{
+    uint32_t etag = this->pageStamp(page, page->version);
+    char extraHeaders[64];
+    sprintf(extraHeaders, "ETag: \"%08x\"\nCache-Control: no-cache\n", etag);
+    char quotedEtag[12];
+    sprintf(quotedEtag, "\"%08x\"", etag);
+    if(this->ri->ifNoneMatch && strstr(this->ri->ifNoneMatch, quotedEtag))
+    {
+        this->requestsCached++;
+        this->renderHttpResponseHeader("text/html", 304, extraHeaders);
+        return;
+    }
+
+    // A layout that changed since the last request for the page may well change
+    // again before the next, so that's rendered directly, and compiled next time.
+    bool layoutHeld = page->layoutVersionLastRequest == page->layoutVersion;
+    page->layoutVersionLastRequest = page->layoutVersion;
+
+    uint32_t stamp = this->pageStamp(page, page->layoutVersion);
+    PageTemplate *t = this->pageCache->find(page, stamp);
+    if(t)
+        this->requestsCached++;
+    else if(layoutHeld && page->templateTooBig != page->layoutVersion + 1)
+    {
+        // Render it once to the side, with markers where the values go.
+        PageCaptureStream recording(this->pageCache->budget);
+        OmXmlWriter recorder(&recording);
+        recorder.setMinified(w.minified);
+        t = new PageTemplate();
+        omCompilingTemplate = t;
+        this->renderPage(recorder, page);
+        omCompilingTemplate = NULL;
+        if(recording.overflowed || recorder.getErrorCount() || !compilePageTemplate(recording, t))
+        {
+            delete t;
+            t = NULL;
+        }
+        else
+        {
+            t->minifiedBytes = recorder.minifiedBytes;
+            t = this->pageCache->add(page, stamp, t);
+        }
+        if(!t)
+            page->templateTooBig = page->layoutVersion + 1; // don't try again until it changes
+    }
+
+    // Either way, it's counted first for the Content-Length, if the connection
+    // stays open after. Otherwise the end of the page is where it closes.
+    int contentLength = -1;
+    if(this->ri->keepAlive)
+    {
+        OmCountingStream counter;
+        OmXmlWriter cw(&counter);
+        cw.setMinified(w.minified);
+        if(t)
+            renderPageTemplate(cw, t);
+        else
+            this->renderPage(cw, page);
+        if(!cw.getErrorCount())
+            contentLength = (int)counter.count;
+    }
+    this->renderHttpResponseHeader("text/html", 200, extraHeaders, contentLength);
+    if(t)
+        renderPageTemplate(w, t);
+    else
+        this->renderPage(w, page);
 }
 
 void OmWebPages::addUrlHandler(const char *path, OmUrlHandlerProc proc, int ref1, void *ref2)
 {
-    UrlHandler *uh = new UrlHandler();
+    UrlHandler *uh = new(this->siteArena.alloc(sizeof(UrlHandler))) UrlHandler();
     // skip leading slash, it's implied throughout in our code here.
     if(path && path[0] == '/')
         path++;
@@ -1843,6 +3444,7 @@ void OmWebPages::addUrlHandler(const char *path, OmUrlHandlerProc proc, int ref1
     uh->ref1 = ref1;
     uh->ref2 = ref2;
     this->urlHandlers.push_back(uh);
+    this->urlHandlerPaths.add(uh->url, uh);
 }
 
 void OmWebPages::addUrlHandler(OmUrlHandlerProc proc, int ref1, void *ref2)
@@ -1852,15 +3454,35 @@ void OmWebPages::addUrlHandler(OmUrlHandlerProc proc, int ref1, void *ref2)
     this->urlHandler.ref2 = ref2;
 }
 
-void OmWebPages::renderHttpResponseHeader(const char *contentType, int response)
+static const char *httpReasonPhrase(int response)
+{
+    switch(response)
+    {
+        case 304: return "Not Modified";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 500: return "Internal Server Error";
+    }
+    return "OK";
+}
+
+void OmWebPages::renderHttpResponseHeader(const char *contentType, int response, const char *extraHeaders, int contentLength)
 {
-    this->wp->addContentF("HTTP/1.1 %d OK\n"
+    // Without a length, an HTTP/1.0 client's connection can only end the body by closing.
+    bool keepAlive = this->ri && this->ri->keepAlive
+        && (this->ri->chunked || contentLength >= 0 || response < 200 || response == 204 || response == 304);
+    this->wp->addContentF("HTTP/1.1 %d %s\n"
                    "Content-type:%s\n"
-                   "Connection: close\n"
+                   "Connection: %s\n"
                           // TODO: consider only allowing CORS on the _status page, for scanning
                           // TODO: having it open on all pages lets a web page operate the device
-                   "Access-Control-Allow-Origin: *\n"
-                   "\n", response, contentType);
+                   "Access-Control-Allow-Origin: *\n",
+                   response, httpReasonPhrase(response), contentType, keepAlive ? "keep-alive" : "close");
+    if(contentLength >= 0)
+        this->wp->addContentF("Content-Length: %d\n", contentLength);
+    if(extraHeaders)
+        this->wp->addContentRaw(extraHeaders); // raw, header values may have "quotes"
+    this->wp->addContentRaw("\n");
 }
 
 void OmWebPages::setValue(const char *pageName, const char *itemName, int value)
@@ -1879,6 +3501,204 @@ int OmWebPages::getValue(const char *pageName, const char *itemName)
     return result;
 }
 
+uint32_t OmWebPages::getValueSerial()
+{
+    return omChangeSerial();
+}
+
+void OmWebPages::renderValueEvents(OmIByteStream *consumer, uint32_t since)
+{
+    bool any = false;
+    for(Page *page : this->pages)
+    {
+        for(PageItem *item : page->items)
+        {
+            if(item->valueSerial > since)
+            {
+                OmPrintfStream::putF(consumer, "event: value\ndata: {\"page\":\"%s\",\"item\":\"%s\",\"value\":%d}\n\n",
+                                     page->id, item->id, item->value);
+                any = true;
+            }
+        }
+    }
+    // the browser sends this back as Last-Event-ID if it reconnects, so it misses nothing.
+    if(any)
+        OmPrintfStream::putF(consumer, "id: %d\n\n", (int)omChangeSerial());
+}
+
+static void putValueRecord(OmIByteStream *consumer, int pageNumber, int itemNumber, uint32_t value)
+{
+    uint8_t record[8] =
+    {
+        (uint8_t)pageNumber, (uint8_t)(pageNumber >> 8),
+        (uint8_t)itemNumber, (uint8_t)(itemNumber >> 8),
+        (uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24)
+    };
+    consumer->putN(record, sizeof(record));
+}
+
+void OmWebPages::renderValueRecords(OmIByteStream *consumer, uint32_t since)
+{
+    bool any = false;
+    for(int pageNumber = 0; pageNumber < (int)this->pages.size(); pageNumber++)
+    {
+        Page *page = this->pages[pageNumber];
+        for(int itemNumber = 0; itemNumber < (int)page->items.size(); itemNumber++)
+        {
+            PageItem *item = page->items[itemNumber];
+            if(item->valueSerial > since)
+            {
+                putValueRecord(consumer, pageNumber, itemNumber, (uint32_t)item->value);
+                any = true;
+            }
+        }
+    }
+    if(any)
+        putValueRecord(consumer, 0xffff, 0xffff, omChangeSerial());
+}
+
+static void putLittle(OmIByteStream *consumer, uint64_t value, int size)
+{
+    uint8_t bytes[8];
+    for(int ix = 0; ix < size; ix++)
+        bytes[ix] = (uint8_t)(value >> (8 * ix));
+    consumer->putN(bytes, size);
+}
+
+void OmWebPages::renderStatusBin(OmXmlWriter &w, uint32_t since)
+{
+    long long now;
+    if(this->ri)
+        now = this->ri->uptimeMillis;
+    else
+    {
+#ifndef NOT_ARDUINO
+        now = millis();
+#else
+        now = 101;
+#endif
+    }
+
+    uint32_t freeHeap = 0;
+#ifdef ARDUINO_ARCH_ESP8266
+    freeHeap = system_get_free_heap_size();
+#endif
+#ifdef ARDUINO_ARCH_ESP32
+    freeHeap = esp_get_free_heap_size();
+#endif
+
+    // Count everything first; the length goes in the header, and the http header.
+    uint32_t layout = 0;
+    int itemCount = 0;
+    for(Page *page : this->pages)
+    {
+        if(page->layoutSerial > layout)
+            layout = page->layoutSerial;
+        for(PageItem *item : page->items)
+            if(!since || item->valueSerial > since)
+                itemCount++;
+    }
+    int eepromIntCount = 0;
+    int fieldCount = OmEepromClass::active ? OmEeprom.getFieldCount() : 0;
+    for(int ix = 0; ix < fieldCount; ix++)
+        if(OmEeprom.getFieldType(ix) == OME_TYPE_INT && OmEeprom.getFieldLength(ix) <= 4
+           && (!since || OmEeprom.getFieldChangeSerial(ix) > since))
+            eepromIntCount++;
+
+    struct { uint8_t tag; uint8_t size; uint64_t value; } scalars[] =
+    {
+        {OMSB_UPTIME_MILLIS, 8, (uint64_t)now},
+        {OMSB_REQUESTS, 4, this->requestsAll},
+        {OMSB_REQUESTS_PARAM, 4, this->requestsParam},
+        {OMSB_REQUESTS_CACHED, 4, this->requestsCached},
+        {OMSB_MAX_HTML, 4, this->greatestRenderLength},
+        {OMSB_FREE_HEAP, 4, freeHeap},
+        {OMSB_CHANGES, 4, omChangeSerial()},
+        {OMSB_SINCE, 4, since},
+        {OMSB_LAYOUT, 4, layout},
+        {OMSB_LEFT_OUT, 4, 0}, // last, and only sent if needed
+    };
+    int scalarCount = sizeof(scalars) / sizeof(scalars[0]) - 1;
+    int length = 8 + 4 + 4;
+    for(int ix = 0; ix < scalarCount; ix++)
+        length += 2 + scalars[ix].size;
+
+    // The length and the counts are 16 bits. If everything won't fit, as many
+    // eeprom ints and then items as will are sent, and OMSB_LEFT_OUT says how
+    // many weren't, so a poller knows it didn't get it all.
+    int itemsSent = itemCount;
+    int eepromIntsSent = eepromIntCount;
+    if(length + 8 * itemCount + 6 * eepromIntCount > 0xffff)
+    {
+        length += 2 + scalars[scalarCount].size;
+        if(eepromIntsSent > (0xffff - length) / 6)
+            eepromIntsSent = (0xffff - length) / 6;
+        if(itemsSent > (0xffff - length - 6 * eepromIntsSent) / 8)
+            itemsSent = (0xffff - length - 6 * eepromIntsSent) / 8;
+        scalars[scalarCount++].value = (itemCount - itemsSent) + (eepromIntCount - eepromIntsSent);
+    }
+    length += 8 * itemsSent + 6 * eepromIntsSent;
+
+    this->renderHttpResponseHeader("application/octet-stream", 200, NULL, length);
+
+    w.putS("OmSB");
+    putLittle(&w, OMSB_VERSION, 1);
+    putLittle(&w, scalarCount, 1);
+    putLittle(&w, length, 2);
+    for(int ix = 0; ix < scalarCount; ix++)
+    {
+        putLittle(&w, scalars[ix].tag, 1);
+        putLittle(&w, scalars[ix].size, 1);
+    }
+    for(int ix = 0; ix < scalarCount; ix++)
+        putLittle(&w, scalars[ix].value, scalars[ix].size);
+
+    putLittle(&w, OMSB_ITEMS, 1);
+    putLittle(&w, 8, 1);
+    putLittle(&w, itemsSent, 2);
+    for(int pageNumber = 0; pageNumber < (int)this->pages.size(); pageNumber++)
+    {
+        Page *page = this->pages[pageNumber];
+        for(int itemNumber = 0; itemNumber < (int)page->items.size() && itemsSent > 0; itemNumber++)
+        {
+            PageItem *item = page->items[itemNumber];
+            if(!since || item->valueSerial > since)
+            {
+                putValueRecord(&w, pageNumber, itemNumber, (uint32_t)item->value);
+                itemsSent--;
+            }
+        }
+    }
+
+    putLittle(&w, OMSB_EEPROM_INTS, 1);
+    putLittle(&w, 6, 1);
+    putLittle(&w, eepromIntsSent, 2);
+    for(int ix = 0; ix < fieldCount && eepromIntsSent > 0; ix++)
+    {
+        if(OmEeprom.getFieldType(ix) == OME_TYPE_INT && OmEeprom.getFieldLength(ix) <= 4
+           && (!since || OmEeprom.getFieldChangeSerial(ix) > since))
+        {
+            putLittle(&w, ix, 2);
+            putLittle(&w, (uint32_t)OmEeprom.getInt(OmEeprom.getFieldName(ix)), 4);
+            eepromIntsSent--;
+        }
+    }
+}
+
+bool OmWebPages::controlValue(int pageNumber, int itemNumber, int value)
+{
+    if(pageNumber < 0 || pageNumber >= (int)this->pages.size())
+        return false;
+    Page *page = this->pages[pageNumber];
+    if(itemNumber < 0 || itemNumber >= (int)page->items.size())
+        return false;
+    PageItem *item = page->items[itemNumber];
+    item->setValue(value);
+    item->doAction(page);
+    this->requestsParam++;
+    return true;
+}
+
 // helper method for the Form
 static void addTextInput(OmXmlWriter &w, const char *label, const char *name, String &value)
 {
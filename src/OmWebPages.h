@@ -59,16 +59,16 @@
 #include "WiFi.h"
 #endif
 #if NOT_ARDUINO
-#include <string>
-#define String std::string
-typedef unsigned char IPAddress[4];
+#include "OmHostWiFi.h"
 #endif
 
 #ifndef UNUSED
 #define UNUSED(x) (void)(x)
 #endif
 
-/*! @brief A callback you provide for value changes of most controls on the web page. */
+/*! @brief A callback you provide for value changes of most controls on the web page.
+ The names are always in RAM, even for pages and controls named with F("..."); those
+ are copies, good only during the call (and cut at 63 chars). */
 typedef void (* OmWebActionProc)(const char *pageName, const char *parameterName, int value, int ref1, void *ref2);
 
 /*! @brief A callback you provide for rendering custom HTML onto a web page. */
@@ -83,6 +83,62 @@ class Page;
 class PageItem;
 /*! Internal class of arbitrary URL handlers */
 class UrlHandler;
+/*! Internal class of OmWebPages, compiled page templates kept for reuse */
+class PageCache;
+/*! Internal class of OmWebPages, writes "_status" as XML or JSON */
+class StatusWriter;
+/*! Internal class of OmWebPages, one route's timings and sizes for "_perf" */
+class PerfRoute;
+/*! Internal struct of OmWebPages, the gzipped and minified copies of a builtin file */
+struct OmWebAsset;
+
+/*! Bytes of compiled page templates to keep for reuse; see setPageCacheBudget() */
+#ifndef OMWP_PAGE_CACHE_BYTES
+#if defined(ARDUINO_ARCH_ESP32) && defined(BOARD_HAS_PSRAM)
+#define OMWP_PAGE_CACHE_BYTES 131072
+#elif defined(ARDUINO_ARCH_ESP32)
+#define OMWP_PAGE_CACHE_BYTES 16384
+#elif defined(ARDUINO_ARCH_ESP8266)
+#define OMWP_PAGE_CACHE_BYTES 0 // heap is tight; turn it on with setPageCacheBudget() if you can spare it
+#else
+#define OMWP_PAGE_CACHE_BYTES 65536
+#endif
+#endif
+
+/*! Routes (pages, url handlers, "_control") that "_perf" keeps numbers for, about 180 bytes each
+ once used. Past that, the rest share one called "(other)". 0 turns it off. */
+#ifndef OMWP_PERF_ROUTES
+#define OMWP_PERF_ROUTES 16
+#endif
+
+/*! Send the builtin style and script minified, as tools/makeAssetsGz.py left them in
+ OmWebPagesAssets.h, and pages without the line breaks between elements. 0 sends them as
+ written, easier to read in the browser. */
+#ifndef OMWP_MINIFY
+#define OMWP_MINIFY 1
+#endif
+
+/*! @brief Tags in "_status.bin". Values 1..0x7f are scalars, listed in the record's
+ descriptor with their sizes; 0x80 and up are sections of fixed-size records. New ones
+ only ever get added, and a reader skips tags it doesn't know by their sizes. */
+typedef enum
+{
+    OMSB_UPTIME_MILLIS = 1, // uint64
+    OMSB_REQUESTS = 2, // uint32, requestsAll
+    OMSB_REQUESTS_PARAM = 3, // uint32
+    OMSB_REQUESTS_CACHED = 4, // uint32
+    OMSB_MAX_HTML = 5, // uint32, greatest render length
+    OMSB_FREE_HEAP = 6, // uint32, 0 where unknown
+    OMSB_CHANGES = 7, // uint32, omChangeSerial(), for ?since= next time
+    OMSB_SINCE = 8, // uint32, the since asked for, 0 for everything
+    OMSB_LAYOUT = 9, // uint32, change serial of the latest page layout change; names and ids may have moved
+    OMSB_LEFT_OUT = 10, // uint32, records that didn't fit the 16 bit length; only there if any didn't
+    OMSB_ITEMS = 0x81, // records of page number, item number (uint16), value (int32)
+    OMSB_EEPROM_INTS = 0x82, // records of field index (uint16), value (int32)
+} EOmStatusBinTag;
+
+/*! Version of the "_status.bin" layout. */
+#define OMSB_VERSION 1
 
 /*! @class Reference to a single control */
 class OmWebPageItem
@@ -99,7 +155,8 @@ public:
     void setVisible(bool visible, const char *name, int value);
     /*! @brief current value */
     int getValue();
-    /*! @brief changes the value, but only visible on next browser load or refresh */
+    /*! @brief changes the value. Open browsers see it right away via the "_events" stream,
+     others on next load or refresh */
     void setValue(int value);
 
     PageItem *privateItem;
@@ -116,6 +173,12 @@ public:
     long long uptimeMillis;
     const char *ssid = "";
     const char *ap = "";
+    bool keepAlive = false; // the server will hold the connection open after this response
+    bool chunked = false; // HTTP/1.1, so the server can frame a response with no length; for 1.0 it closes instead
+    bool webSocket = false; // the server answers "_ws", so pages can try it before "_events"
+    const char *ifNoneMatch = ""; // request's If-None-Match header, for answering 304
+    const char *acceptEncoding = ""; // request's Accept-Encoding header, "gzip" lets us send compressed assets
+    uint32_t parseTicks = 0; // omTicks() the server spent reading the request's headers, for "_perf"
 };
 
 /*! @brief A class that routes and serves web pages, and manages control values, typically works with OmWebServer for the network interface */
@@ -195,6 +258,27 @@ public:
     /*! @brief Add a string of static prebuilt HTML. Included in web page unchecked, you're on your own! */
     void addStaticHtml(String staticHtml);
 
+    // +----------------------------------
+    // | Names in flash
+    // | On the ESP8266, string constants take RAM unless they're kept in flash. Page, item,
+    // | option and checkbox names can be PSTR("..."), or F("...") with these, and they stay
+    // | there, streamed out at each render and never copied. "_info" shows the RAM saved.
+    // |
+
+    void *beginPage(const __FlashStringHelper *pageName, bool listed = true);
+    void addPageLink(const __FlashStringHelper *pageLink, OmWebActionProc proc = NULL, int ref1 = 0, void *ref2 = 0);
+    OmWebPageItem *addButton(const __FlashStringHelper *buttonName, OmWebActionProc proc = NULL, int ref1 = 0, void *ref2 = 0);
+    OmWebPageItem *addSlider(const __FlashStringHelper *sliderName, OmWebActionProc proc = NULL, int value = 0, int ref1 = 0, void *ref2 = 0);
+    OmWebPageItem *addSlider(int rangeLow, int rangeHigh, const __FlashStringHelper *sliderName, OmWebActionProc proc = NULL, int value = 0, int ref1 = 0, void *ref2 = 0);
+    OmWebPageItem *addTime(const __FlashStringHelper *itemName, OmWebActionProc proc = NULL, int value = 0, int ref1 = 0, void *ref2 = 0);
+    OmWebPageItem *addColor(const __FlashStringHelper *itemName, OmWebActionProc proc = NULL, int value = 0, int ref1 = 0, void *ref2 = 0);
+    OmWebPageItem *addSelect(const __FlashStringHelper *itemName, OmWebActionProc proc = NULL, int value = 0, int ref1 = 0, void *ref2 = 0);
+    void addSelectOption(const __FlashStringHelper *optionName, int optionValue);
+    OmWebPageItem *addCheckbox(const __FlashStringHelper *itemName, const __FlashStringHelper *checkboxName, OmWebActionProc proc = NULL, int value = 0, int ref1 = 0, void *ref2 = 0);
+    void addCheckboxX(const __FlashStringHelper *checkboxName, int value = 0);
+    /*! @brief Static HTML from flash, like F("<hr/>"). Unlike a String, it isn't copied. */
+    void addStaticHtml(const __FlashStringHelper *staticHtml);
+
     /*! @brief By default, any header proc is used on every page. Disable for current page here. */
     void allowHeader(bool allowHeader);
 
@@ -249,6 +333,13 @@ public:
     /*! @brief set the background color for next web request, 0xRRGGBB */
     void setBgColor(int bgColor); // like 0xff0000 red, 0xffffff white.
 
+    /*! @brief Bytes to keep compiled pages in. A page is rendered once into a template, on the
+     second request with the same layout, and sent after that by splicing the current values into it;
+     an unchanged page gets a 304. 0 turns it off. On ESP32 boards with PSRAM, that's where they go.
+     Pages with addHtml() blocks, an arrival action, or a custom header or footer proc, are always
+     rendered fresh. */
+    void setPageCacheBudget(int bytes);
+
     // +----------------------------------
     // | Statistics
     // | Publicly readable variables giving insight into the server behavior.
@@ -256,6 +347,9 @@ public:
     
     /*! Total number of requests served */
     unsigned int requestsAll = 0;
+
+    /*! Page requests answered from a compiled template, or with 304 Not Modified */
+    unsigned int requestsCached = 0;
     
     /*! Total number of parameter-change requests served */
     unsigned int requestsParam = 0;
@@ -263,15 +357,60 @@ public:
     /*! Maximum size of pages served */
     unsigned int greatestRenderLength = 0;
 
+    /*! Maximum size pages would have been, without OMWP_MINIFY */
+    unsigned int greatestRenderLengthUnminified = 0;
+
+    /*! Lowest free heap seen at the start of a request, 0 until the first one (and off the ESPs) */
+    unsigned int heapFreeLowest = 0;
+
     // +----------------------------------
     // | Internal methods
     // | But you could use them in a urlHandler.
     // |
     void renderInfo(OmXmlWriter &w); // builtin "_info" page
     void renderStatusXml(OmXmlWriter &w, bool asText); // builtin "_status" url
-
-    /*! @brief in a OmUrlHandlerProc, set the mimetype (like "text/plain") and response code (200 is OK) */
-    void renderHttpResponseHeader(const char *contentType, int response);
+    /*! @brief "_status?since=N", only what changed after change serial N; see omChangeSerial() */
+    void renderStatusXmlSince(OmXmlWriter &w, bool asText, uint32_t since);
+    /*! @brief "_status.json", the same status as JSON */
+    void renderStatusJson(OmXmlWriter &w, bool asText);
+    /*! @brief "_status.json?since=N" */
+    void renderStatusJsonSince(OmXmlWriter &w, bool asText, uint32_t since);
+    /*! @brief "_perf" as text, or "_perf.json": for each route, how many requests and errors, and histograms
+     of the time spent parsing, rendering and blocked writing to the socket, and of bytes sent. */
+    void renderPerf(OmXmlWriter &w, bool asJson);
+    /*! @brief start the "_perf" numbers over, as "_perf?reset=1" does after showing them */
+    void resetPerf();
+    /*! @brief OmWebServer calls this once the response from handleRequest() is all written, with how long
+     the writes blocked (in omTicks()) and whether the client took every byte. */
+    void requestFinished(uint32_t stallTicks, bool ok);
+    void renderStyleFile(OmXmlWriter &w, bool asWritten = false); // builtin "_om.css" url, "?min=0" for not minified
+    void renderScriptFile(OmXmlWriter &w, bool asWritten = false); // builtin "_om.js" url
+
+    /*! @brief counts up every time any item's value changes (it's the shared omChangeSerial()) */
+    uint32_t getValueSerial();
+    /*! @brief render a Server-Sent Event for each item whose value changed since the given
+     serial, for the "_events" stream that OmWebServer holds open */
+    void renderValueEvents(OmIByteStream *consumer, uint32_t since);
+    /*! @brief the same changes as packed 8-byte records for the "_ws" websocket: page number and
+     item number (uint16), value (int32), little endian. Numbers are as in the ids, so p2 i5 is 2, 5.
+     A last record with page and item 0xffff carries the serial they bring you up to. */
+    void renderValueRecords(OmIByteStream *consumer, uint32_t since);
+    /*! @brief "_status.bin", the status as one little endian binary record, for pollers:
+     "OmSB", version (uint8), scalar count n (uint8), total length (uint16);
+     n descriptor pairs of tag, size (uint8 each); the n scalar values, in that order, of those sizes;
+     then sections of tag (uint8), record size (uint8), record count (uint16), and the records.
+     Tags are EOmStatusBinTag. With since nonzero, only items and eeprom fields changed after it.
+     Records past the 16 bit length are left out, and counted in OMSB_LEFT_OUT.
+     tools/omStatusBin.py decodes it, and omWebBench -b checks it. */
+    void renderStatusBin(OmXmlWriter &w, uint32_t since);
+    /*! @brief set an item's value as if from its control in a browser, and call its action proc */
+    bool controlValue(int pageNumber, int itemNumber, int value);
+
+    /*! @brief in a OmUrlHandlerProc, set the mimetype (like "text/plain") and response code (200 is OK)
+     extraHeaders, if given, are more header lines, each ending with "\n". If you know exactly how
+     many bytes the body will be, pass contentLength, and the server can keep the connection open
+     without chunking it. */
+    void renderHttpResponseHeader(const char *contentType, int response, const char *extraHeaders = NULL, int contentLength = -1);
 
     /*! @brief in a OmUrlHandlerProc Render the beginning of the page, leaving <body> element open and ready. */
     static void renderPageBeginning(OmXmlWriter &w, const char *pageTitle = "", int bgColor = 0xffffff, OmWebPages *p = NULL);
@@ -297,8 +436,15 @@ private:
     };
 
     bool doAction(const char *pageName, const char *itemName);
+    bool applyControl(const char *pageId, const char *itemId, const char *valueS);
     static void renderStyle(OmXmlWriter &w, int bgColor = 0xffffff);
     static void renderScript(OmXmlWriter &w);
+    static void renderStyleContent(OmXmlWriter &w);
+    static void renderScriptContent(OmXmlWriter &w);
+    static uint32_t styleEtag();
+    static uint32_t scriptEtag();
+    void renderConstantFile(OmXmlWriter &w, const char *contentType, uint32_t etag, void (*renderContent)(OmXmlWriter &w),
+                            const OmWebAsset &asset, bool asWritten);
     
     /*! Render a simple menu of all the known pages. It's the default page, too. */
     void renderTopMenu(OmXmlWriter &w);
@@ -307,10 +453,32 @@ private:
     PageItem *findPageItem(const char *pageName, const char *itemName, bool byId = false);
     
     Page *homePage = NULL;
+    OmArena siteArena; // the pages and url handlers themselves; each page has its own for its items
     std::vector<Page *> pages;
     std::vector<UrlHandler *>urlHandlers;
+    OmNameIndex pageNames; // the same pages and handlers, hashed for lookup by name
+    OmNameIndex urlHandlerPaths;
     Page *currentPage = 0; // if a page is active.
 
+    PageCache *pageCache = NULL;
+    uint32_t siteVersion = 0; // bumped by changes that show on every page, like the page list
+    uint32_t pageEtagNonce = 0;
+    void renderStatus(StatusWriter &w);
+    int flashStringBytes();
+    void renderStatusSince(StatusWriter &w, uint32_t since);
+    bool isPageRepeatable(Page *page);
+    bool isPageCacheable(Page *page);
+    uint32_t pageStamp(Page *page, uint32_t version);
+    void renderPage(OmXmlWriter &w, Page *page);
+    void renderCacheablePage(OmXmlWriter &w, Page *page);
+
+    PerfRoute *perfRoutes = 0; // in order of first request, allocated from siteArena as they come
+    int perfRouteCount = 0;
+    PerfRoute *perfLast = 0; // the most recent request's, for requestFinished()
+    long long perfResetMillis = 0;
+    PerfRoute *findPerfRoute(const char *route);
+    void perfRecord(const char *route, uint32_t parseTicks, uint32_t renderTicks, unsigned int bytes, bool error);
+
     UrlHandler urlHandler; // generic handler if no specific urls match. Over to you!
 
     PageItem *currentSelect = 0; // addSelectOption applies to the most recently begun select.
@@ -0,0 +1,424 @@
+/*
+ * OmWebPagesAssets.h
+ *
+ * Gzipped and minified builtin style and script for OmWebPages, served
+ * in place of the text as written. GENERATED by tools/makeAssetsGz.py,
+ * do not edit.
+ */
+
+#ifndef __OmWebPagesAssets__
+#define __OmWebPagesAssets__
+
+#include <stdint.h>
+
+#ifdef NOT_ARDUINO
+#define PROGMEM
+#define memcpy_P memcpy
+#endif
+
+// _om.css: 1950 bytes, gzipped to 689; minified 1432, gzipped to 602
+#define OM_ASSET_STYLE_ETAG 0x26952ea1
+#define OM_ASSET_STYLE_SIZE 1950
+static const uint8_t omAssetStyleGz[689] PROGMEM =
+{
+    0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x8d,0x54,0x4d,0x8f,0xda,0x30,
+    0x10,0xbd,0xef,0xaf,0xb0,0x84,0x56,0xdb,0x56,0x18,0x11,0x58,0x16,0xd5,0x51,0x4f,
+    0xbd,0xf6,0xdc,0x4b,0xd5,0x83,0x13,0x4f,0x12,0x0b,0x63,0x5b,0x8e,0x53,0xa0,0x11,
+    0xff,0xbd,0xfe,0x48,0xd8,0x00,0x5e,0x95,0x20,0x45,0x31,0xe3,0x99,0x79,0xf3,0xe6,
+    0xcd,0x7c,0xe9,0x2b,0x25,0x2d,0xae,0xe8,0x9e,0x8b,0x13,0xa1,0x86,0x53,0x71,0x7e,
+    0x7a,0x42,0xb7,0x8f,0x36,0x30,0xf7,0x2f,0x44,0xe7,0x68,0x61,0x51,0x74,0x6a,0xf9,
+    0x5f,0x20,0xab,0xb5,0x3e,0xe6,0xd3,0x18,0xdf,0x55,0x67,0x38,0x98,0x39,0xda,0x2b,
+    0xa9,0x5a,0x4d,0x4b,0xc8,0xd1,0x41,0x19,0x86,0x0f,0x86,0x6a,0x52,0x18,0xa0,0x3b,
+    0xec,0xcf,0x39,0x52,0x7f,0xc0,0x54,0x42,0x1d,0x08,0xed,0xac,0xca,0x51,0xa9,0x84,
+    0x32,0xa4,0x10,0xb4,0xdc,0x9d,0xef,0x11,0x54,0xca,0xec,0x51,0xbf,0xa7,0xa6,0xe6,
+    0x12,0x17,0xca,0x5a,0xb5,0x27,0x4b,0x7d,0x4c,0xdc,0xa4,0x44,0x70,0xb9,0x43,0x3d,
+    0xb2,0x70,0xb4,0x98,0x41,0xa9,0x0c,0xb5,0x5c,0x49,0x82,0xa4,0x92,0x90,0x9f,0x93,
+    0xd5,0x5d,0xbc,0xee,0x9c,0x3a,0xc9,0xc0,0x38,0x5b,0xd2,0x73,0xd1,0x0a,0xee,0xcc,
+    0x3f,0xa9,0xe8,0xc0,0x65,0x64,0xbc,0xd5,0x82,0x9e,0x08,0x97,0xde,0x01,0x17,0x42,
+    0x95,0xbb,0x1c,0xbd,0x93,0x95,0xbd,0x39,0xb2,0xd0,0x81,0x33,0xdb,0x90,0xed,0x26,
+    0x89,0x7e,0x11,0x68,0x18,0x03,0xde,0xba,0x0e,0xf5,0x0b,0xa8,0x2c,0x59,0xa5,0xcb,
+    0x5f,0xb4,0x20,0xa0,0xb4,0x1f,0x45,0x70,0x84,0x53,0x4b,0x0c,0xaf,0x1b,0x9b,0xcc,
+    0xde,0x40,0xb9,0x2b,0xd4,0xf1,0x07,0x2d,0x40,0xfc,0x07,0xc0,0xd7,0x64,0xfe,0x26,
+    0x9b,0x37,0xab,0x79,0xb3,0x8e,0x4c,0x52,0xc1,0x6b,0x49,0x4a,0x90,0x16,0x4c,0xe2,
+    0x72,0xc4,0x3a,0x95,0xd3,0xeb,0x83,0x65,0x72,0xa9,0x3b,0xfb,0xcb,0x9e,0x34,0x7c,
+    0x7b,0x19,0x41,0xbf,0xfc,0x46,0xfd,0xfd,0x4d,0xff,0xe0,0x03,0x14,0x3b,0xee,0xe0,
+    0x68,0x0d,0xd4,0x50,0x59,0x02,0x09,0x62,0xb8,0xbf,0x1d,0x9b,0xe3,0x93,0x26,0x8c,
+    0x0d,0x78,0xde,0x3e,0xb2,0x16,0x4e,0xb9,0xb5,0x51,0x4e,0x30,0xe4,0xd0,0x70,0x9b,
+    0x8a,0x1e,0xae,0x39,0xf1,0x83,0xc1,0x86,0x32,0xde,0xb5,0x64,0x93,0x0e,0x15,0xee,
+    0x90,0x95,0x3e,0xa2,0x56,0x39,0x89,0xa1,0xd9,0x66,0xb3,0xf9,0x20,0xde,0xf5,0x4c,
+    0xe0,0x74,0xc0,0x87,0x19,0x24,0xe1,0x13,0x58,0x8a,0xc9,0x49,0x81,0x68,0x46,0x0b,
+    0xf6,0x58,0x9e,0x85,0x8b,0x9b,0xcd,0xfd,0x7b,0xe5,0xde,0x9d,0x43,0x29,0x27,0x0d,
+    0x5f,0x2f,0xdf,0x47,0xe2,0xd5,0x13,0x8b,0xc6,0xf6,0x93,0x2c,0x98,0x34,0x65,0x8c,
+    0xcb,0x3a,0x9c,0x9c,0x6d,0x82,0x61,0x06,0x4b,0xff,0xcb,0x07,0x42,0xad,0xd2,0x41,
+    0x31,0x23,0xb3,0x99,0x67,0x62,0xb0,0x45,0x72,0x70,0x90,0xfd,0x95,0x7d,0x14,0x46,
+    0xd7,0xba,0x5b,0x51,0x8d,0x64,0x58,0x13,0x23,0xd6,0xbb,0x5e,0x84,0x15,0x95,0x47,
+    0xc8,0x25,0x15,0xe5,0xa7,0x6c,0xb9,0x7c,0x46,0x18,0xf9,0x52,0x3e,0xe7,0xe3,0x0e,
+    0x08,0xc3,0xef,0xa3,0xb8,0xba,0xfb,0xe4,0x62,0x98,0xa8,0x7e,0x35,0xad,0x74,0xeb,
+    0x0e,0x31,0x7a,0x58,0x8c,0x97,0x35,0xd9,0x70,0xc6,0x40,0x5e,0xf8,0x89,0xd5,0xf8,
+    0x25,0x98,0x0f,0x7f,0x38,0x06,0xe2,0x4e,0x0c,0x94,0x93,0xc6,0x7b,0x46,0xe2,0xe3,
+    0x77,0x7f,0x4d,0x5e,0x55,0x39,0xf2,0xce,0x4f,0x85,0x62,0xa7,0x7e,0x68,0xc0,0xd6,
+    0x47,0x1b,0x71,0x6c,0x2e,0x91,0x6f,0x93,0x84,0xd5,0x35,0xd1,0x8f,0x9b,0xa8,0x1a,
+    0xdc,0xf0,0xa5,0xe6,0x2c,0x6e,0xdd,0x51,0xd1,0x28,0xf4,0xf4,0x8c,0xee,0xbd,0x09,
+    0x19,0x9d,0xe3,0x4e,0xc5,0xa6,0x93,0x92,0x16,0x02,0xb0,0x35,0x0e,0xb6,0x0b,0x3e,
+    0x4c,0x1f,0xf2,0xb8,0xae,0xb5,0xf8,0xf6,0xb6,0x7e,0xcf,0x30,0xcd,0x37,0xf6,0x1a,
+    0xad,0x1f,0x4e,0x6b,0x9b,0x6e,0x5f,0x3c,0x54,0x4a,0x3c,0x5d,0x50,0x4d,0x84,0x3c,
+    0x1c,0x6e,0x30,0x64,0xcb,0xe7,0x6b,0xdc,0xb5,0x12,0xae,0xa1,0x46,0xb1,0x4b,0x4b,
+    0x3d,0xb9,0x08,0x47,0x39,0x38,0xb4,0xff,0x00,0x9a,0xf4,0xb9,0xc8,0x9e,0x07,0x00,
+    0x00,
+};
+static const char omAssetStyleMin[] PROGMEM = R"MIN(*{font-family:arial}pre,pre a,.t{font-size:23px;font-family:Courier,monospace;word-wrap:break-word;overflow:auto;color:black}form{margin-bottom:0px}a:link{text-decoration:none}pre a:link{text-decoration:underline}.sliderValue{display:inline-block;font-size:16px;width:75px}.colorValue{font-size:16px;margin-left:20px}.selectValue{font-size:16px;float:right}.checkboxLabel{font-size:16px;margin-left:9px}h1,h2,h3{text-align:center}select{font-size:24px;margin-left:20px}input[type='checkbox']{-webkit-appearance:none;width:20px;height:20px;background:white;border-radius:5px;border:2px solid #555;margin-bottom:-5px}input[type='checkbox']:checked{background:#abd}.box1,.box2,.button{font-size:30px;width:420px;margin:10px;padding:10px;background:#e0e0e0;border-top-left-radius:15px;border-bottom-right-radius:15px;-webkit-user-select:none}.button{border:2px solid black;width:calc(100% - 30px);display:block}.box2{display:inline-block;font-size:22px;padding:7px;width:auto;overflow:hidden;margin-right:0px;margin-top:0px}.box1:hover,.box2:hover{background:#e0ffe0}body{width:470px;padding:5px;margin:0px;margin-top:5px}input[type=range]{-webkit-appearance:none;border:0px}input[type=range]::-webkit-slider-runnable-track{height:5px;background:#663;border:none;border-radius:3px}input[type=range]::-webkit-slider-thumb{-webkit-appearance:none;border:none;height:50px;width:50px;border-radius:10%;background:goldenrod;margin-top:-22px})MIN";
+static const uint8_t omAssetStyleMinGz[602] PROGMEM =
+{
+    0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x8d,0x53,0xcd,0x8e,0x9b,0x30,
+    0x10,0x7e,0x95,0x48,0xab,0xd5,0xb6,0x55,0x1c,0x01,0x59,0x12,0xd5,0xa8,0xa7,0x5e,
+    0x7b,0xee,0xa5,0xea,0xc1,0xc6,0x03,0x58,0x18,0xdb,0x32,0xa6,0x24,0x45,0xbc,0x7b,
+    0x6d,0x03,0x09,0x49,0xb3,0xdd,0x2a,0x02,0x0d,0x99,0xf1,0xcc,0xf7,0x33,0xfe,0x34,
+    0x14,0x4a,0x5a,0x54,0x90,0x86,0x8b,0x33,0x26,0x86,0x13,0x31,0x6a,0x03,0x5b,0xf7,
+    0x6c,0xc8,0x76,0x67,0xa7,0x74,0xcb,0x7f,0x03,0x4e,0xf6,0xfa,0x94,0xad,0xab,0xbf,
+    0xaa,0xce,0x70,0x30,0xdb,0x46,0x49,0xd5,0x6a,0x92,0x43,0xd6,0x2b,0xc3,0x50,0x6f,
+    0x88,0xc6,0xd4,0x00,0xa9,0x91,0xff,0xce,0xd4,0x2f,0x30,0x85,0x50,0x3d,0x26,0x9d,
+    0x55,0x59,0xae,0x84,0x32,0x98,0x0a,0x92,0xd7,0x63,0xa1,0x4c,0x33,0x34,0xc4,0x94,
+    0x5c,0x22,0xaa,0xac,0x55,0x0d,0x8e,0xf4,0x69,0x24,0x58,0x70,0x59,0x0f,0x16,0x4e,
+    0x16,0x31,0xc8,0x95,0x21,0x96,0x2b,0x89,0xa5,0x92,0x30,0x06,0x5c,0x8f,0xf3,0x9d,
+    0x64,0x60,0x5c,0x06,0xc6,0x5d,0x2b,0xb8,0x8b,0xbf,0x13,0xd1,0xc1,0xc0,0x78,0xab,
+    0x05,0x39,0x63,0x2e,0x7d,0x0e,0x51,0xa1,0xf2,0x3a,0xbb,0xb2,0x8a,0x0f,0x8e,0x55,
+    0xcf,0x99,0xad,0xf0,0x31,0x75,0xc3,0x77,0x01,0xe0,0x74,0xf4,0xae,0x6a,0x46,0x2a,
+    0xa0,0xb0,0x38,0xf1,0x40,0x77,0x2d,0x08,0xc8,0xed,0xc3,0x62,0xc7,0x98,0x58,0x6c,
+    0x78,0x59,0x59,0xd7,0xb3,0x82,0xbc,0xa6,0xea,0xf4,0x8d,0x50,0x10,0xff,0x6a,0xfb,
+    0xd9,0x75,0xad,0xe2,0x6d,0x95,0x6c,0xab,0xfd,0x44,0x90,0x08,0x5e,0x4a,0x9c,0x83,
+    0xb4,0x60,0xc6,0x69,0xde,0xda,0x93,0xd7,0x47,0xb8,0xb8,0xd4,0x9d,0xfd,0x61,0xcf,
+    0x1a,0xbe,0xbc,0x2c,0xa3,0x5f,0x7e,0x0e,0xa8,0x07,0x5a,0x73,0xd7,0x52,0x6b,0x20,
+    0x86,0xc8,0x1c,0x82,0xa6,0x33,0x7b,0x7f,0x32,0xab,0xc0,0x03,0x9e,0x62,0xea,0x2c,
+    0x2a,0x8d,0x72,0xb2,0xe2,0xbe,0xe2,0x16,0x32,0xea,0xdc,0x04,0x83,0x0c,0x61,0xbc,
+    0x6b,0x71,0xea,0x4b,0xc2,0x3f,0x38,0xd1,0xa7,0x4d,0xab,0x9c,0xe6,0x9b,0xa7,0x34,
+    0x4d,0xb3,0x5b,0x47,0x51,0xfa,0x26,0x22,0x1c,0x42,0x60,0xc3,0x6a,0xd4,0x13,0xa1,
+    0x6c,0xdc,0xb9,0x74,0xbc,0xf5,0xef,0xc4,0xbd,0x3b,0xd7,0x47,0xae,0x48,0xef,0xa3,
+    0x8b,0x65,0xaf,0x01,0xe9,0x34,0x10,0xc7,0x3e,0xd6,0x84,0x31,0x2e,0xcb,0xe9,0x63,
+    0xdd,0x17,0x22,0xff,0x5b,0x48,0x58,0xa5,0x83,0x60,0x0b,0x9b,0xf8,0x4a,0x67,0x06,
+    0x8e,0x82,0x77,0x37,0xf9,0x45,0xc0,0xae,0x75,0x55,0x93,0x17,0xd3,0x56,0x2e,0x18,
+    0xff,0xd2,0x23,0xec,0xf9,0x8c,0x35,0x27,0x22,0xff,0x10,0x47,0xd1,0xf3,0x06,0x6d,
+    0x3c,0x85,0x8f,0xd9,0xb2,0x9a,0x61,0x27,0x03,0xe9,0xe4,0xbd,0x75,0x4d,0x92,0x15,
+    0xc7,0xe3,0x45,0x87,0x70,0xb5,0x2e,0x17,0xad,0xe2,0x8c,0x81,0x5c,0x7c,0x08,0x3c,
+    0xf0,0x55,0x27,0xcf,0x3d,0xdc,0xb3,0xa0,0x32,0xae,0xfc,0xb1,0x49,0xeb,0x29,0x1e,
+    0x6e,0x55,0x2b,0x0a,0x88,0x46,0xaa,0xd8,0x79,0x98,0x25,0x3f,0xae,0x65,0x4e,0xaf,
+    0xf2,0xdf,0x4d,0xb8,0xb3,0xdd,0xed,0x5b,0x09,0x6f,0xef,0xe0,0xac,0x5c,0xf4,0xe8,
+    0x10,0xc6,0xcb,0xa9,0xe9,0x5e,0x23,0xd3,0x49,0x49,0xa8,0x00,0x64,0x8d,0x83,0x3a,
+    0xcc,0x4b,0x9b,0xde,0x19,0x7e,0x38,0xec,0x97,0xb6,0xab,0x11,0x8b,0xa1,0xfb,0xff,
+    0x9a,0x64,0xab,0xae,0xa1,0xef,0x81,0x0e,0xf1,0x02,0xe2,0xba,0x9b,0x21,0xbc,0x1d,
+    0x1a,0x47,0xcf,0x6b,0x88,0xa5,0x12,0xce,0x27,0xa3,0xd8,0x5a,0x37,0xe4,0x2d,0x1e,
+    0xff,0x00,0xdf,0x4b,0x38,0xab,0x98,0x05,0x00,0x00,
+};
+
+// _om.js: 9480 bytes, gzipped to 2529; minified 5331, gzipped to 1713
+#define OM_ASSET_SCRIPT_ETAG 0x7e757b60
+#define OM_ASSET_SCRIPT_SIZE 9480
+static const uint8_t omAssetScriptGz[2529] PROGMEM =
+{
+    0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xdd,0x5a,0xeb,0x73,0xdb,0x36,
+    0x12,0xff,0xee,0xbf,0x02,0x49,0xe6,0x4c,0x72,0xa2,0x50,0xb2,0x9c,0xa6,0x1e,0xcb,
+    0xba,0x4c,0xe3,0xa6,0xad,0x6f,0xf2,0xb8,0x39,0xbb,0x8f,0x99,0x4c,0xc6,0x03,0x91,
+    0x90,0xc4,0x09,0x45,0x28,0x00,0xa8,0xc7,0xa4,0xfe,0xdf,0x6f,0x17,0xe0,0x0b,0x7c,
+    0x59,0x4e,0xd3,0x2f,0x95,0xa6,0xb5,0x08,0x02,0xbb,0x8b,0xdf,0x3e,0xb0,0xbb,0xc8,
+    0xd1,0x11,0x81,0xcf,0x3c,0x4d,0x02,0x15,0xf1,0x84,0x08,0xf6,0xf9,0x4d,0x24,0x15,
+    0x4b,0x98,0x20,0xae,0xa7,0xdf,0x7d,0xd1,0xff,0xc7,0x4f,0xc0,0x13,0xc9,0x63,0xe6,
+    0xc7,0x7c,0xe1,0xaa,0x65,0x24,0x7d,0xc1,0xe4,0x1a,0xc6,0xd8,0x0d,0xdb,0x29,0x33,
+    0xf9,0xee,0x48,0xff,0x19,0x0e,0xc9,0xef,0x4b,0x96,0x10,0xb5,0x64,0x44,0x32,0xb1,
+    0x01,0x6a,0x7c,0x3e,0x67,0x42,0xea,0x91,0xc7,0xb7,0x5b,0xf9,0x98,0x6c,0xd9,0x4c,
+    0xf2,0xe0,0x13,0x53,0x03,0x24,0xac,0x04,0x8f,0xc9,0x86,0xc6,0x29,0x93,0x64,0xc1,
+    0xc9,0x8c,0xab,0x25,0xd9,0xd2,0xbd,0x24,0x20,0x54,0xa4,0x06,0x39,0xd5,0x28,0x21,
+    0x67,0x64,0xb6,0x57,0x0c,0x24,0x0d,0xb8,0x08,0xe5,0x39,0x59,0xd3,0x05,0x23,0x49,
+    0xba,0x9a,0x31,0x31,0x80,0xa9,0x6c,0x95,0x3d,0x10,0x37,0x8d,0x12,0x75,0xf2,0xc2,
+    0x1b,0x18,0xba,0xc4,0x85,0xc7,0xd3,0x31,0x3c,0xc6,0x91,0x52,0x31,0x23,0x2c,0x09,
+    0x23,0x9a,0xf8,0x9a,0xf4,0x86,0x8a,0x5c,0x8a,0x6b,0x2d,0x14,0x99,0x02,0x99,0x38,
+    0x9e,0xd8,0xf0,0x48,0x58,0x73,0x69,0xa6,0xb9,0xc8,0xd7,0x30,0x7c,0x47,0x57,0x2c,
+    0x63,0x52,0x87,0x0c,0xe9,0x6e,0x80,0xd6,0x3b,0x2d,0x92,0x6b,0xe6,0x4c,0x70,0x27,
+    0xce,0x68,0xe7,0x00,0xcb,0x98,0x03,0x28,0x54,0x30,0x32,0x8f,0x12,0x20,0xe2,0x9c,
+    0x8c,0xcf,0x4f,0x47,0xc3,0x13,0x87,0xa8,0x68,0x95,0x41,0xb1,0x27,0x4b,0xa5,0xd6,
+    0x05,0xc9,0x68,0xee,0xda,0x92,0x1e,0x1f,0xdb,0xa2,0x83,0x5a,0x68,0xb8,0xbf,0x56,
+    0x14,0x50,0x9a,0x4e,0xc9,0x09,0x4e,0x30,0xfc,0xfd,0x48,0x5e,0x25,0x8a,0x2d,0x50,
+    0x12,0xcf,0x2b,0x28,0x96,0xe2,0xe6,0x22,0x1b,0x70,0x11,0x03,0xb6,0x25,0x3f,0x52,
+    0x45,0x7f,0x8b,0xd8,0xd6,0xc5,0x87,0x1f,0x84,0xa0,0xfb,0x57,0x29,0x2a,0xd3,0x3d,
+    0xf3,0xbc,0x89,0xb5,0xd4,0x2c,0xf3,0x25,0x53,0xbf,0x6a,0xe8,0xdd,0xd1,0x00,0xd4,
+    0x23,0x24,0x03,0xae,0x1a,0x2f,0x5f,0xa6,0x33,0xa9,0x44,0x94,0x2c,0xdc,0x13,0x0f,
+    0x34,0xa1,0x04,0xc2,0xd1,0x4f,0x63,0x5c,0xa1,0x91,0xa3,0xfd,0x20,0x3a,0x57,0xa8,
+    0x76,0xf7,0x39,0x68,0xa8,0x75,0xa2,0x8d,0x1d,0x6a,0xd8,0xcd,0xd6,0xce,0xf4,0x36,
+    0x1b,0x74,0x55,0x2a,0x92,0x72,0xec,0xce,0xd2,0x35,0xff,0x1f,0xfb,0x9c,0xc1,0xf6,
+    0xc7,0xdb,0x37,0xbf,0x80,0xde,0x60,0x00,0x6c,0x5a,0xb9,0x15,0x32,0x38,0xc9,0xa7,
+    0x61,0xf8,0x7a,0xc3,0x12,0x95,0xbb,0x9b,0xeb,0xc4,0x9c,0x86,0xce,0xa0,0xea,0x82,
+    0xf5,0x35,0x7c,0xcd,0x12,0xd7,0xf9,0xf9,0xf5,0x0d,0x4c,0x73,0x86,0xb7,0x99,0xe4,
+    0x2f,0x11,0xd9,0xa9,0x43,0x9e,0x1a,0x57,0x78,0x4a,0x9c,0x63,0xc4,0x49,0x8f,0xe4,
+    0x80,0xe9,0x51,0x6d,0x7d,0x7a,0x38,0xb3,0x43,0x9b,0xba,0xde,0x7a,0x36,0x98,0xf9,
+    0x31,0x6e,0x09,0x49,0xbc,0x5e,0xcd,0xa8,0x58,0x70,0x30,0xc8,0x29,0xf9,0xf0,0x71,
+    0x62,0xbd,0xbb,0x4a,0xd6,0xa9,0xba,0xd1,0xd6,0x5a,0xbe,0x2c,0x3c,0x26,0xe4,0xef,
+    0x45,0xb6,0xda,0x2d,0x7d,0x25,0xe0,0xab,0x55,0xa4,0xfe,0x2b,0x78,0x50,0x77,0x18,
+    0x9b,0xe2,0x87,0x7c,0xc9,0x47,0xa0,0x0d,0x76,0xc8,0xfc,0x84,0x6f,0xab,0x50,0x82,
+    0x23,0x61,0x44,0x29,0xe9,0x11,0xb9,0xe4,0x69,0x1c,0x42,0xa0,0x08,0xe2,0x34,0x64,
+    0xfa,0x6d,0xc9,0x97,0x26,0x61,0x36,0xd7,0x2c,0x4b,0x85,0x00,0x15,0x10,0x37,0x06,
+    0xd2,0x52,0x79,0x06,0x17,0x33,0x0d,0xd1,0xd0,0x93,0xd0,0xf9,0x48,0xba,0x0e,0x91,
+    0x7b,0xd5,0x09,0x1f,0xbd,0xe2,0x10,0x0c,0x69,0xe2,0x5a,0x00,0x95,0x12,0x77,0x3a,
+    0x58,0x29,0xac,0x6b,0x42,0x41,0x02,0xc1,0x0e,0x4c,0x19,0x64,0x7e,0xb6,0xa5,0x91,
+    0x82,0x9f,0x03,0x22,0x39,0x40,0x07,0x92,0xc3,0xcb,0xad,0xef,0xfb,0x99,0x48,0x8a,
+    0x50,0x1d,0x18,0x78,0x0a,0x1b,0xc8,0x67,0xd0,0x05,0x85,0xb0,0xb8,0x8d,0x20,0x62,
+    0xa2,0xbc,0x66,0x2f,0x66,0x2b,0xbe,0xc5,0xb8,0x43,0x50,0x80,0x16,0x28,0xdf,0x18,
+    0xb2,0x6e,0xae,0x39,0xd7,0xb3,0xd6,0x1e,0xf4,0xf9,0xf2,0xf0,0x25,0xfd,0x72,0xe9,
+    0x10,0x8c,0x10,0x05,0x80,0xb4,0xd0,0xdb,0x63,0x66,0xe2,0xd7,0x71,0xb2,0xa0,0x7f,
+    0x38,0x89,0xbb,0x41,0xed,0x90,0x78,0x49,0xc6,0x23,0x72,0x4e,0x4e,0x46,0x23,0xa3,
+    0x49,0x14,0xb0,0x38,0xd7,0x48,0x40,0xe1,0x04,0xa4,0x9f,0xd0,0x00,0xc9,0x2a,0x0d,
+    0x96,0x64,0x4e,0xc1,0xaf,0x45,0x2d,0x74,0xdc,0x35,0xe5,0x28,0xbc,0x47,0x6f,0xbb,
+    0xee,0x3e,0x2d,0x8a,0xe9,0x00,0x5e,0x2f,0xcf,0x15,0xdb,0x65,0xa6,0x1d,0x38,0xdc,
+    0xa3,0x94,0xe6,0xa2,0x2c,0x64,0x94,0xb2,0xe3,0xd9,0xa6,0x5d,0x59,0xb3,0x1e,0x10,
+    0xfb,0xc0,0xcc,0x1d,0x1f,0x50,0xab,0xc4,0x4f,0x05,0x99,0xc4,0x15,0x1e,0x3c,0x38,
+    0xcd,0x8f,0x42,0x8c,0x5b,0xb7,0xda,0x94,0x9d,0x49,0xcb,0x54,0x98,0x18,0xf2,0x20,
+    0x5d,0x81,0x13,0xfb,0x0b,0xa6,0x5e,0xc7,0x0c,0x7f,0xbe,0xda,0x5f,0x85,0xae,0xa1,
+    0xe4,0x55,0x57,0xe1,0x90,0x2f,0xd5,0x1e,0x52,0x18,0x2d,0x1c,0xac,0x76,0x9e,0xd0,
+    0x11,0x7e,0x1d,0xad,0x3e,0xe3,0xe5,0x98,0x64,0x2c,0x04,0xdb,0x93,0x34,0x51,0x51,
+    0x4c,0x68,0xa0,0x52,0x1a,0xc7,0xfb,0xcc,0x78,0x14,0x0b,0xeb,0x24,0xa3,0x04,0x62,
+    0xf5,0x2f,0x37,0x6f,0xdf,0xe4,0x72,0x6b,0x81,0x4b,0x88,0xda,0x63,0x60,0xe9,0x68,
+    0x5f,0xb4,0x34,0x97,0x9a,0x7c,0x3b,0x56,0x93,0xbb,0x22,0x2e,0xdb,0xf9,0x48,0x1c,
+    0x85,0x2c,0x03,0xd9,0xfc,0xce,0x97,0x9a,0xa7,0x2a,0xd0,0xad,0x30,0x9b,0x69,0x75,
+    0xa0,0xbf,0x06,0xe6,0x6f,0x0e,0x72,0x27,0xc4,0x99,0xcc,0x3d,0x20,0x97,0x9b,0xb7,
+    0x60,0x36,0xc3,0x19,0xce,0x9d,0x70,0x55,0xb0,0x6e,0x31,0xe8,0xfb,0x56,0xd7,0x53,
+    0xe6,0xaa,0x03,0x57,0x99,0xfc,0xdd,0xea,0xe8,0xd7,0xc7,0x48,0x7f,0x9c,0xc9,0xa1,
+    0x20,0x5b,0x22,0x04,0x98,0xd0,0xea,0xf4,0xf5,0xa9,0x35,0xcd,0x4a,0xca,0x4a,0xd2,
+    0xcd,0x9c,0xb9,0xaa,0x9e,0x60,0xd3,0x81,0xf6,0x61,0xca,0xfa,0x87,0xc3,0xdd,0x8f,
+    0x5d,0x75,0x51,0x7b,0x7c,0xc0,0x5c,0xe1,0x72,0x49,0x93,0x05,0x73,0xf1,0xa7,0x0e,
+    0x14,0xb7,0x09,0xa4,0x91,0x39,0x94,0xc5,0x68,0x1d,0xcd,0x32,0xc4,0xd9,0x95,0x41,
+    0x81,0x5d,0xb1,0xb2,0x0d,0xbe,0xbe,0xd5,0x07,0xc3,0xd9,0x46,0xe4,0x7e,0x78,0x3b,
+    0x57,0x55,0xe1,0x2e,0x85,0x6f,0x33,0x70,0x4c,0x64,0xf3,0x54,0xfa,0x16,0xad,0xdc,
+    0x42,0xa9,0x66,0x20,0xf9,0xab,0x9e,0x6d,0x49,0xaf,0xb9,0xe6,0x72,0xc9,0x82,0x4f,
+    0x33,0xbe,0xeb,0x5b,0xa6,0xf9,0x07,0xd9,0x44,0xc7,0xab,0x49,0x69,0x8a,0xda,0xc6,
+    0x5e,0x70,0xd1,0x10,0x85,0x76,0xab,0x6c,0x7c,0x4d,0x86,0x85,0x90,0xb1,0x38,0x50,
+    0x5c,0x9e,0x83,0xff,0x3a,0xbd,0x3e,0x6a,0x6d,0x79,0x40,0x6c,0x1b,0xab,0x17,0xc5,
+    0x31,0x0b,0x54,0x66,0x66,0xe6,0xa1,0xf0,0x54,0xfd,0x64,0x48,0xa4,0x22,0xee,0x3f,
+    0x8a,0xf4,0xdc,0x6f,0x7e,0x14,0x59,0x5e,0x66,0x58,0x18,0x9d,0xa3,0xa5,0x40,0xb1,
+    0xb0,0xc5,0x93,0x08,0xf3,0xb6,0x5f,0xaf,0x4c,0xb1,0x90,0x14,0xb9,0x73,0x9f,0x1b,
+    0x56,0x36,0x56,0xa5,0x5a,0x55,0x12,0xd4,0x08,0xb0,0x67,0x2c,0xc1,0x1d,0xa7,0xab,
+    0x16,0x28,0xf6,0x32,0xe3,0xe1,0x3e,0x33,0xec,0x19,0x0d,0x3e,0x2d,0x04,0x4f,0x91,
+    0xa7,0x31,0xf1,0xc7,0x4f,0xe6,0x23,0xfc,0x3e,0xb6,0xd3,0xae,0xd6,0xac,0xfd,0x0b,
+    0x54,0x02,0x49,0x08,0x45,0x43,0xcc,0x03,0x8a,0x43,0xbe,0x60,0x58,0x59,0x62,0xad,
+    0x01,0xf9,0xeb,0x19,0xa6,0xaa,0x2d,0xc5,0x2b,0x8b,0x25,0xcb,0x25,0x7e,0x34,0x45,
+    0xbb,0xff,0xab,0x22,0x5f,0x8e,0xf0,0x7b,0x88,0xc8,0xa4,0x29,0x33,0x95,0x32,0x5a,
+    0x24,0x28,0x4d,0xbb,0xd8,0xed,0x07,0x74,0x66,0xec,0x99,0x29,0x1a,0x4d,0xe5,0x83,
+    0x3f,0x83,0x78,0xeb,0xac,0x0a,0x8c,0x63,0xed,0x17,0xaf,0xf8,0x2e,0x81,0x01,0x59,
+    0x37,0x4b,0x30,0x0c,0xa8,0xce,0x21,0x51,0x31,0xf9,0xfc,0x12,0xca,0x3c,0x82,0xbb,
+    0x5b,0xfb,0xf6,0x39,0x98,0x51,0x46,0xa2,0xba,0x2d,0x02,0xdb,0xae,0x93,0xf6,0xe5,
+    0x3a,0x86,0xf3,0xcb,0x19,0x38,0xb5,0x18,0x90,0x7b,0xef,0xa8,0x1c,0x9e,0x73,0xe1,
+    0x46,0x3b,0x34,0xc7,0x06,0xe5,0xbe,0x5e,0x0d,0xbd,0xac,0xcc,0x06,0x8a,0x8d,0xc5,
+    0x1f,0xa2,0xdd,0xc7,0x49,0xf7,0xb2,0x1e,0x8f,0xb2,0x48,0xd7,0x0a,0x05,0xb0,0x15,
+    0x5a,0x8f,0x2e,0x5e,0x8d,0x8b,0x0e,0x47,0xd3,0xb2,0x7d,0x53,0x2e,0xa8,0x37,0x20,
+    0xee,0xda,0x63,0x82,0x15,0x85,0x1b,0x9a,0xfc,0xfb,0x02,0xc5,0x37,0x88,0x10,0x2d,
+    0x76,0xd7,0x12,0x44,0x81,0xc3,0x6f,0xa6,0xe9,0xb9,0x4e,0xe5,0x12,0xe2,0xf3,0x5c,
+    0xf0,0x55,0xa5,0x6d,0x8a,0x74,0xd0,0x98,0x43,0x6c,0x03,0x52,0x6c,0x14,0x30,0x41,
+    0x66,0x82,0x6f,0x25,0xb6,0x54,0x05,0x8e,0xea,0xc9,0x50,0x6e,0x42,0x7d,0x19,0x29,
+    0x88,0x45,0x73,0xbf,0x1e,0x9e,0xd5,0x15,0xd4,0x11,0x9a,0xcd,0x61,0x4d,0x4b,0x50,
+    0x6d,0xd9,0x6b,0x21,0xcf,0x88,0xdb,0xd9,0x94,0xf9,0xf3,0x4f,0x32,0xf2,0xc8,0x05,
+    0xf9,0x0e,0xdc,0xb3,0xad,0x4b,0x86,0xfb,0x9b,0x31,0xec,0x6d,0x84,0x82,0x2e,0x70,
+    0x1b,0x22,0x5a,0x2c,0x75,0x53,0x63,0x00,0xea,0x01,0x20,0xe7,0xfa,0x39,0x52,0x7e,
+    0xff,0x09,0x9c,0xb3,0xb4,0xf5,0x1c,0x3d,0xf4,0xe0,0xed,0xb7,0x0b,0x59,0x31,0xa8,
+    0xca,0x4a,0x80,0xc3,0x30,0x3a,0x3e,0x36,0x1c,0x7d,0xb5,0x5f,0xeb,0xd6,0xaa,0xa3,
+    0x73,0x90,0xce,0x48,0x19,0x55,0x4e,0x65,0xcc,0x53,0xf4,0xa9,0xec,0x98,0x64,0x25,
+    0x6f,0xc2,0xf9,0x8a,0x5f,0x67,0x39,0xf3,0x0b,0xcf,0xf3,0x21,0xa5,0x0b,0x98,0xfb,
+    0xec,0x45,0xd3,0xd9,0x54,0xd1,0x63,0xef,0xcd,0x6c,0xa2,0x6a,0x56,0x73,0x58,0xdf,
+    0xb2,0x67,0x7f,0x98,0x05,0x38,0x7d,0xc1,0x67,0x15,0x25,0xa9,0xd2,0x9d,0x3f,0xb3,
+    0xcd,0x63,0x32,0x1e,0x3d,0xff,0x7e,0xd2,0x03,0x03,0x00,0x80,0x9b,0x7f,0x4b,0xd5,
+    0xd2,0x9f,0xc7,0x1c,0x62,0x5e,0x4e,0x63,0x48,0x5e,0x8c,0x4a,0x08,0xc6,0x1e,0x6a,
+    0xe3,0x3c,0xc3,0x0c,0xff,0xe4,0xf3,0xfe,0x85,0xf3,0xca,0x69,0x93,0xf6,0xd3,0xe9,
+    0x9e,0x64,0xaa,0x48,0x88,0x40,0xa2,0x5c,0xf4,0xd1,0x0e,0x8e,0x19,0xb0,0xe7,0x47,
+    0x56,0x58,0x3e,0x0c,0x3c,0xaf,0x67,0xcb,0x95,0x68,0xa2,0x33,0x76,0x74,0x5c,0x93,
+    0x34,0x58,0xb1,0x5f,0x5b,0x34,0x86,0xe3,0xd1,0xa0,0x8c,0xce,0x13,0xe2,0xd2,0x07,
+    0xe7,0x8a,0xc6,0x65,0x76,0x1e,0x9c,0x9d,0xd1,0xee,0xe9,0x53,0x5b,0xb6,0x46,0xd4,
+    0xae,0x42,0xe0,0x9e,0x90,0x8b,0x0b,0xbd,0xb4,0x86,0x42,0xc3,0x02,0x6d,0x5b,0x38,
+    0xac,0xec,0xe9,0x89,0xb5,0x8d,0xa6,0xd8,0x91,0x75,0x52,0x5e,0x47,0x49,0x50,0x39,
+    0x2e,0x8b,0xe0,0x16,0xeb,0x4e,0xf9,0x4f,0x5c,0xe8,0x5e,0xba,0x74,0x5b,0x42,0xd9,
+    0xa3,0x2c,0xb7,0xd0,0x33,0xae,0x79,0x2a,0x02,0xe6,0xf5,0x2a,0xb7,0x60,0x6a,0x68,
+    0x66,0xed,0xfc,0xca,0x72,0xd7,0x19,0xde,0x32,0xfd,0xee,0xa5,0x44,0xb9,0xca,0x96,
+    0xba,0x16,0xd3,0x0a,0x3a,0x05,0x99,0x96,0x86,0xbf,0x89,0x34,0x95,0x16,0x05,0x3b,
+    0xb0,0xe7,0xfa,0x80,0x3e,0x6b,0x7e,0x01,0xf5,0x9f,0xeb,0xf7,0xef,0x7c,0x7d,0x10,
+    0xbb,0xcc,0x0f,0xa9,0xa2,0x0f,0xe9,0x7f,0x5a,0x47,0xc8,0xc6,0x37,0x87,0xc8,0xc6,
+    0x37,0xad,0xaa,0x4d,0xe3,0x30,0xef,0xef,0xa1,0x76,0x54,0x11,0x46,0x93,0xef,0x13,
+    0xd3,0x59,0xed,0x53,0xe4,0xef,0x6c,0x66,0x26,0xb5,0xa9,0xb1,0x69,0x11,0xb6,0x62,
+    0xf1,0x0a,0x45,0x9b,0xfc,0x9c,0x42,0xc6,0x6b,0xbf,0xdb,0xe6,0xba,0x2e,0x38,0xb8,
+    0x6e,0x91,0x91,0xae,0x05,0x57,0x1c,0x6c,0x5b,0xc7,0x45,0xbc,0x13,0x90,0x10,0x9b,
+    0xa0,0x9a,0xda,0x4a,0x79,0x3e,0x1c,0xea,0x92,0x6a,0xab,0x7f,0x61,0xdc,0x2a,0x56,
+    0x2d,0xb9,0x54,0xba,0x22,0xbb,0xdd,0xde,0x6b,0x2c,0x5b,0xe9,0xcf,0xa2,0x84,0x8a,
+    0xfd,0x8d,0x0e,0xbf,0xc4,0xa1,0x98,0xbd,0x99,0x4b,0x28,0xc7,0x9a,0xc6,0xb1,0x84,
+    0x4f,0x70,0x13,0xcd,0x66,0xbd,0x6d,0x1b,0xc5,0x76,0xf1,0xe2,0xab,0xe7,0xde,0x0b,
+    0x66,0x6c,0x65,0xc5,0x09,0x6b,0xec,0xe0,0xd4,0x97,0x78,0x1c,0x4f,0x5b,0x6d,0xb5,
+    0xeb,0xfe,0x50,0xd6,0x2f,0x10,0x5b,0x2d,0xcf,0x0e,0x7d,0x18,0xb1,0x00,0xa0,0x33,
+    0x72,0x31,0xcd,0xa9,0xf8,0x78,0xdf,0xfb,0x86,0x25,0x0b,0xb5,0x34,0x6f,0xa7,0xe4,
+    0xcc,0x56,0x7d,0xd3,0x1f,0x90,0xe0,0xda,0x48,0x9c,0x53,0x59,0x14,0x37,0x8a,0xd1,
+    0xae,0xf5,0x22,0xb0,0x7a,0xa9,0xd5,0xb1,0x0e,0x24,0x1b,0x77,0xae,0x05,0x13,0x35,
+    0x2c,0x61,0x1b,0xbb,0x39,0x7c,0xda,0xbd,0xd9,0x8a,0x67,0x35,0x26,0xa7,0x63,0xc3,
+    0xe4,0x79,0x27,0x13,0xac,0xd3,0x8e,0xee,0xf5,0x51,0x67,0x9d,0x5f,0x07,0x0e,0x88,
+    0x13,0xe5,0x09,0xd4,0xa0,0xca,0xee,0xaa,0xc9,0xad,0xc6,0xee,0xae,0xd3,0x1c,0x82,
+    0x98,0x4b,0x76,0x88,0xf9,0x75,0x5f,0xa9,0x57,0x40,0x33,0x36,0xda,0x04,0xab,0x52,
+    0x2b,0xda,0xc1,0x61,0x40,0x4e,0x47,0x56,0x3d,0xd8,0x09,0x4c,0x33,0x18,0x98,0xfb,
+    0xb6,0xca,0x25,0x0d,0x76,0xc9,0x96,0x91,0x2c,0xf2,0x6d,0x7d,0xc7,0x84,0xb3,0x89,
+    0x54,0x82,0xd1,0x15,0x94,0xa6,0x71,0x0c,0xe7,0xae,0x5f,0x47,0x23,0x0b,0x60,0xc5,
+    0x89,0xdc,0x8c,0xef,0x3f,0xbe,0x7f,0x8b,0x35,0x01,0x8e,0x41,0x01,0xce,0xc2,0x6a,
+    0xa8,0x6f,0x6b,0x85,0xc8,0xcc,0x28,0xec,0x0a,0x1b,0x74,0xf5,0x83,0x82,0x14,0x71,
+    0x06,0xc9,0x8f,0xeb,0xa0,0x03,0x3d,0x33,0xff,0x4e,0xa2,0x96,0xa3,0x66,0xab,0x0d,
+    0xc8,0xf7,0x9d,0x70,0x15,0x13,0xd4,0xeb,0x2c,0x4a,0x36,0xff,0x25,0x95,0x75,0xfe,
+    0x5b,0xe0,0x6d,0x73,0xa8,0x47,0xef,0xc9,0x51,0xa7,0x5e,0x3a,0x02,0xf4,0x5d,0xde,
+    0x3a,0x39,0x32,0x60,0x7c,0x4e,0x59,0x1c,0xbf,0xe5,0xa9,0x2c,0x8e,0xfd,0xe2,0xa8,
+    0x00,0x49,0x14,0x40,0x68,0xfe,0xe4,0xad,0x26,0xf3,0x94,0x55,0x35,0x45,0xb7,0x29,
+    0x07,0x18,0x76,0xb5,0xf9,0xf7,0x74,0xec,0x95,0x54,0xa7,0x27,0x13,0xf3,0x2f,0x4a,
+    0x16,0x09,0x17,0x8c,0xac,0x70,0x4c,0x12,0x3a,0x57,0x90,0x9f,0xcd,0x23,0x21,0xf1,
+    0x82,0x15,0xef,0xec,0xb4,0x2d,0x94,0x54,0x4a,0x02,0xc7,0xc7,0x9b,0x8b,0xb1,0x57,
+    0x29,0x74,0x32,0x4a,0x68,0x40,0x9a,0x5a,0x6e,0x31,0x9b,0x63,0xe4,0x05,0x13,0xf4,
+    0x28,0x9c,0x60,0xc9,0x30,0x5d,0x13,0x30,0xb9,0x93,0xc1,0x48,0xdf,0xeb,0x6a,0x46,
+    0x52,0x51,0xa1,0x86,0x78,0xe9,0x0c,0x6f,0x4e,0x07,0xe3,0x6c,0xb1,0xd9,0x56,0x7b,
+    0x9b,0x65,0xba,0x79,0xe9,0x3c,0xf9,0x7e,0x84,0x5f,0x48,0x94,0x9f,0xb0,0x11,0x7e,
+    0x8b,0x93,0xa2,0x59,0x92,0x5a,0x10,0x15,0x2a,0x6a,0x6f,0x53,0x7d,0x5d,0x77,0xe9,
+    0xbb,0x8a,0x5b,0x76,0x77,0x94,0xaa,0x31,0xe2,0x2f,0x74,0x93,0xbe,0xb6,0x97,0x74,
+    0x52,0x0d,0x1e,0x18,0xe4,0xf0,0xbf,0xff,0x03,0x76,0xdb,0xc5,0x24,0x08,0x25,0x00,
+    0x00,
+};
+static const char omAssetScriptMin[] PROGMEM = R"MIN(function reqListener(){console.log(this.responseText)}
+var controlSocket=null;function sendControl(page,itemName,value){var v=Number(value);if(controlSocket&&controlSocket.readyState==1&&Number.isInteger(v)){var record=new DataView(new ArrayBuffer(8));record.setUint16(0,parseInt(page.substring(1)),true);record.setUint16(2,parseInt(itemName.substring(1)),true);record.setInt32(4,v,true);controlSocket.send(record.buffer);return;}
+var oReq=new XMLHttpRequest();oReq.addEventListener('load',reqListener);oReq.open('GET','/_control?page='+page+'&item='+itemName+'&value='+value);oReq.send();}
+var itemEmbargoes=[];var itemInputTimes=[];function doOrEmbargo(itemName,commitProc){itemInputTimes[itemName]=Date.now();if(!Boolean(itemEmbargoes[itemName])){commitProc();itemEmbargoes[itemName]=setTimeout(function(){itemEmbargoes[itemName]=null;commitProc();},controlSocket?20:100);}}
+function clearEmbargo(itemName){clearTimeout(itemEmbargoes[itemName]);itemEmbargoes[itemName]=null;}
+function colorInput(item,page,itemName){doOrEmbargo(itemName,function(){colorCommit(item,page,itemName);});}
+function sliderInput(slider,page,sliderName){var textId=slider.id+'_value';var text=document.getElementById(textId);text.style.color='#a0a0a0';text.innerHTML=slider.value;doOrEmbargo(sliderName,function(){sliderCommit(slider,page,sliderName);});}
+function colorCommit(slider,page,sliderName){clearEmbargo(sliderName);var textId=slider.id+'_value';var text=document.getElementById(textId);text.style.color='#000000';text.innerHTML=slider.value;var cv='0x'+slider.value.substring(1);sendControl(page,sliderName,cv);}
+function sliderCommit(slider,page,sliderName){clearEmbargo(sliderName);var textId=slider.id+'_value';var text=document.getElementById(textId);text.style.color='#000000';text.innerHTML=slider.value;sendControl(page,sliderName,slider.value);}
+function timeChange(timeInput_nope,page,timeInputName){var s=page+'_'+timeInputName;var timeInput=document.getElementById(s);var timeCheckbox=document.getElementById(s+'_checkbox');var value=timeInput.value+'/'+(timeCheckbox.checked?'1':'0');sendControl(page,timeInputName,value);}
+function selectChange(select,page,selectName,url){var textId=select.id+'_value';var text=document.getElementById(textId);text.innerHTML=select.value;sendControl(page,selectName,select.value);if(url==''){document.body.style.backgroundColor="#f0f0f0";setTimeout(function(){window.location.reload();},800);}
+else if(url!='_'){document.body.style.backgroundColor="#C0C0C0";setTimeout(function(){window.location.assign(url);},800);}}
+function checkboxChange(page,checkboxGroupName,allCheckBoxnames){var checkboxNameArray=allCheckBoxnames.split(',');var value=0;for(ix in checkboxNameArray){var aCheckboxName=checkboxNameArray[ix];var aCheckbox=document.getElementById(aCheckboxName);if(aCheckbox.checked)
+value+=parseInt(aCheckbox.value);}
+var textId=page+'_'+checkboxGroupName+'_value';var text=document.getElementById(textId);text.innerHTML=value;sendControl(page,checkboxGroupName,value);}
+function setItemValue(page,itemName,value){if(Date.now()-(itemInputTimes[itemName]||0)<500)
+return;var s=page+'_'+itemName;var input=document.getElementById(s);var text=document.getElementById(s+'_value');if(input&&input.type=='color'){input.value='#'+('00000'+value.toString(16)).slice(-6);if(text)
+text.innerHTML=input.value;return;}
+if(input&&input.type=='time'){var minutes=value&2047;input.value=('0'+Math.floor(minutes/60)).slice(-2)+':'+('0'+minutes%60).slice(-2);document.getElementById(s+'_checkbox').checked=(value&0x8000)!=0;return;}
+if(input)
+input.value=value;for(var ix=0,aCheckbox;(aCheckbox=document.getElementById(s+'_checkbox_'+ix));ix++)
+aCheckbox.checked=(value&(1<<ix))!=0;if(text){text.style.color='#000000';text.innerHTML=value;}}
+var valueSince=0;function listenForEvents(){if(!window.EventSource)
+return;var valueEvents=new EventSource('/_events?since='+valueSince);valueEvents.addEventListener('value',function(e){var v=JSON.parse(e.data);setItemValue(v.page,v.item,v.value);});}
+function listenOnSocket(){if(!window.WebSocket)
+return listenForEvents();var opened=false;var ws=new WebSocket((location.protocol=='https:'?'wss://':'ws://')+location.host+'/_ws?since='+valueSince);ws.binaryType='arraybuffer';ws.onopen=function(){opened=true;controlSocket=ws;};ws.onmessage=function(e){var records=new DataView(e.data);for(var ix=0;ix+8<=records.byteLength;ix+=8){var page=records.getUint16(ix,true);var item=records.getUint16(ix+2,true);if(page==0xffff)
+valueSince=records.getUint32(ix+4,true);else
+setItemValue('p'+page,'i'+item,records.getInt32(ix+4,true));}};ws.onclose=function(){controlSocket=null;if(opened)
+setTimeout(listenOnSocket,3000);else
+listenForEvents();};}
+document.addEventListener('DOMContentLoaded',function(){var since=document.body.getAttribute('data-values');if(since==null)
+return;valueSince=since;if(document.body.hasAttribute('data-ws'))
+listenOnSocket();else
+listenForEvents();});var quellMouse=0;function button(button,page,buttonName,v,url){if(v>=2)quellMouse=1;if(quellMouse&&v<2)return;v&=1;button.style.backgroundColor=v?'#707070':'#e0e0e0';sendControl(page,buttonName,v);if(url=='')
+setTimeout(function(){window.location.reload();},500);else if(url!='_'){document.body.style.backgroundColor="#C0C0C0";setTimeout(function(){window.location.assign(url);},1000);}})MIN";
+static const uint8_t omAssetScriptMinGz[1713] PROGMEM =
+{
+    0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xd5,0x58,0x6d,0x6f,0xdb,0x36,
+    0x10,0xfe,0xee,0x5f,0x91,0x34,0x98,0x29,0xc1,0xae,0x22,0xbb,0x6d,0x1a,0x44,0xd1,
+    0x82,0x25,0xcd,0xda,0x0c,0x49,0x33,0x2c,0x59,0x37,0xa0,0x28,0x02,0x59,0xa2,0x6d,
+    0xa1,0xb2,0xe8,0x8a,0x94,0x5f,0x90,0xe6,0xbf,0xef,0x78,0x27,0xc9,0x94,0x65,0xa7,
+    0x29,0x8a,0x0d,0x98,0xfd,0xc1,0x12,0x79,0x77,0xbc,0x97,0xe7,0x8e,0x77,0x1e,0xe6,
+    0x69,0xa8,0x62,0x91,0xee,0x64,0xfc,0xcb,0x65,0x2c,0x15,0x4f,0x79,0x66,0xd9,0xf7,
+    0xa1,0x48,0xa5,0x48,0xb8,0x93,0x88,0x91,0xa5,0xc6,0xb1,0x74,0x32,0x2e,0xa7,0xb0,
+    0xc6,0x6f,0xf9,0x42,0xd9,0x0f,0xad,0x59,0x90,0xed,0x00,0x8d,0xca,0x44,0x72,0x23,
+    0xc2,0xcf,0x5c,0xf9,0x69,0x9e,0x24,0xde,0xb0,0x94,0x26,0x79,0x1a,0x9d,0xd1,0xbe,
+    0x35,0x0d,0x46,0xbc,0x1b,0x2b,0x3e,0x79,0x1f,0x4c,0x78,0x77,0x16,0x24,0x39,0xb7,
+    0xef,0xb5,0x80,0x99,0xff,0x3e,0x9f,0x0c,0xe0,0x3c,0x5a,0xf3,0xe2,0xa1,0x55,0x93,
+    0xd9,0x6e,0xd7,0x5e,0x41,0x87,0x20,0x5a,0xde,0xa8,0x40,0x71,0xdf,0xef,0xb5,0xdb,
+    0xc4,0xec,0xc4,0xf2,0x22,0x55,0x7c,0xa4,0xc5,0xd8,0x24,0x37,0xe3,0xa1,0xc8,0x22,
+    0x3f,0xe5,0xf3,0x9d,0x37,0x81,0x0a,0x3e,0xc4,0x7c,0x6e,0xe9,0x97,0x5f,0xb2,0x2c,
+    0x58,0x9e,0xe6,0xc3,0x21,0xd0,0x1e,0xda,0xb6,0x47,0x74,0x8e,0xe4,0xea,0xcf,0x38,
+    0x55,0xbd,0x03,0xcb,0xed,0x4e,0x83,0x4c,0x72,0x90,0x87,0x4a,0x3b,0x32,0x1f,0x48,
+    0x95,0xc5,0xe9,0xc8,0xea,0xd9,0x76,0x57,0x65,0x5a,0xc9,0x06,0x53,0x7f,0xc5,0x54,
+    0x1a,0xf9,0x0d,0x46,0x20,0x7d,0xd1,0xb7,0x5e,0x76,0x67,0xc5,0x4e,0xdd,0x4a,0xed,
+    0x3a,0xab,0x20,0x1e,0xa0,0xb2,0x9a,0x57,0xe5,0x59,0xea,0x91,0xdf,0xc5,0x1f,0xfc,
+    0x0b,0x1a,0xf7,0xf7,0xd5,0xe5,0x3b,0xa5,0xa6,0xf0,0x9a,0x73,0xa9,0x2c,0xdb,0xd3,
+    0x3b,0x4e,0x10,0x45,0xe7,0x33,0x9e,0xaa,0x2a,0x9a,0x2c,0x11,0x41,0xc4,0xba,0x46,
+    0x80,0x0b,0x4a,0x31,0xe5,0xa9,0xc5,0xde,0x9e,0xdf,0xb2,0x2e,0xdb,0xbf,0x2b,0xb4,
+    0x38,0xd1,0x96,0xfb,0xac,0xa3,0x7f,0x3a,0xac,0xad,0x4d,0x82,0xb7,0xd2,0x32,0x58,
+    0xc1,0x60,0xc1,0x52,0x11,0x34,0x94,0x84,0x3a,0xdb,0x85,0x7e,0x9a,0xf6,0x7c,0x32,
+    0x08,0xb2,0x91,0xe0,0xd2,0xff,0xf8,0xc9,0x2b,0x17,0x2f,0xd2,0x69,0xae,0x6e,0xe3,
+    0x09,0xad,0x56,0x58,0x89,0xc4,0x75,0x56,0xd0,0x57,0x1e,0xec,0x86,0x62,0x32,0x89,
+    0xd5,0xef,0x99,0x08,0xed,0xfb,0x3a,0xef,0xc7,0x92,0xe6,0x93,0x0f,0xd1,0xe5,0x4e,
+    0x2a,0xe6,0x16,0x62,0x67,0xf7,0x54,0x00,0x64,0x83,0xd4,0xaa,0x29,0xb0,0x22,0xb7,
+    0x35,0xac,0x4b,0xa9,0x9a,0x65,0x33,0x99,0x0f,0x11,0xd2,0x07,0x89,0x5c,0x59,0xa5,
+    0x8e,0x16,0x29,0xb1,0x89,0x1a,0x71,0x5f,0x93,0xfb,0xd0,0xad,0x05,0xf4,0xa4,0xef,
+    0x1e,0xf5,0x5c,0x17,0xd6,0x1f,0x5a,0x95,0xcd,0x21,0x28,0xda,0x30,0x1a,0xf4,0xd3,
+    0xcb,0xe5,0xe1,0xdb,0xcc,0xf0,0x1e,0x55,0xc5,0x3c,0x44,0x24,0x22,0x43,0xc7,0xa1,
+    0xac,0x6e,0x2d,0x11,0xed,0xfb,0x8d,0x7e,0x37,0x2c,0x46,0xf6,0x33,0xb4,0x6c,0x13,
+    0xbf,0xf7,0x60,0x9b,0x87,0xc9,0x24,0x8e,0x78,0x71,0x1a,0x3d,0x13,0x3d,0x3d,0xd3,
+    0x89,0x1a,0x08,0x0a,0x0a,0xc8,0x45,0xe4,0xd3,0xb2,0x13,0x47,0x1d,0x76,0x87,0x48,
+    0x62,0x5e,0xb9,0xeb,0x47,0x22,0xcc,0x27,0x80,0x60,0x67,0xc4,0xd5,0x79,0xc2,0xf5,
+    0xe3,0xe9,0xf2,0x22,0xb2,0x88,0xd5,0xf6,0xf4,0xaf,0x23,0xd5,0x12,0xea,0x13,0xea,
+    0xe8,0xb3,0xbd,0xc0,0xd5,0x5f,0x46,0x5b,0x71,0x0a,0x18,0x7f,0x77,0x7b,0x75,0x59,
+    0x9e,0x82,0x07,0x78,0xa6,0xbd,0x2b,0xad,0x4c,0x8b,0x69,0xb5,0x30,0x79,0x8b,0x11,
+    0x6b,0x66,0x9b,0x4e,0xda,0x66,0x76,0x2d,0xd8,0xa6,0xa8,0x7f,0xcf,0x1f,0x2e,0x7e,
+    0x1e,0xf7,0x07,0xd6,0xf0,0x99,0xcf,0xdc,0x05,0xeb,0x98,0x1b,0xb5,0xea,0xe5,0x35,
+    0x2a,0xb9,0xe1,0xba,0x70,0xb6,0x01,0x02,0xff,0x4f,0x67,0x3c,0x66,0xa6,0x49,0x58,
+    0x33,0x58,0x41,0xa6,0x9e,0x8d,0x83,0x74,0xc4,0x2d,0xfd,0x88,0xe0,0xbf,0x4b,0xa1,
+    0xac,0x92,0xd9,0xd5,0xda,0x0a,0xfd,0xd2,0xa7,0xba,0x7a,0xc7,0x3a,0xb5,0x5d,0xb2,
+    0xaf,0x5c,0xd9,0x6a,0xa4,0xb4,0x2b,0xc2,0xb3,0x31,0x0f,0x3f,0x0f,0xc4,0x62,0x3b,
+    0x2d,0x9c,0x12,0x16,0x44,0x8c,0xf8,0xa8,0x74,0x57,0xc7,0x90,0x45,0x1d,0xb6,0xcf,
+    0x3a,0x96,0x29,0xd2,0x41,0x36,0x1e,0x9d,0xb0,0x1e,0x3b,0x62,0x2e,0xdb,0x00,0x82,
+    0x9a,0xf2,0xdd,0xa6,0x67,0x24,0x4f,0x78,0xa8,0x0a,0xdf,0xd0,0x4b,0x01,0x05,0x7c,
+    0x46,0xae,0x3c,0x4b,0xea,0x25,0x01,0xb7,0x7e,0x20,0xea,0x46,0x68,0x49,0xd4,0xb6,
+    0xd0,0xae,0x74,0x30,0x09,0xf1,0x12,0x01,0xa5,0x7c,0x9f,0x31,0x5d,0x1d,0x8b,0x13,
+    0x07,0x22,0x5a,0x16,0x80,0x1a,0x04,0xe1,0xe7,0x51,0x26,0x72,0x2d,0x4f,0x43,0xeb,
+    0xd9,0xde,0xd0,0xd5,0xdf,0x67,0xde,0xe6,0x3b,0x63,0x1e,0xa7,0x91,0x98,0x43,0x13,
+    0x15,0x06,0x7a,0x05,0x1a,0x18,0x7d,0x15,0xe3,0x15,0x71,0x88,0x37,0x42,0x8b,0x27,
+    0x92,0xef,0xd0,0xb1,0xbb,0x3e,0xa0,0xe2,0xa9,0xe7,0x9e,0xb9,0xfa,0xfb,0xd4,0x73,
+    0x03,0x29,0xe3,0x51,0xaa,0x0f,0x59,0x1d,0x6d,0xd6,0xb0,0x22,0xee,0x45,0xb8,0xd0,
+    0x47,0xe5,0xda,0x5b,0x38,0x76,0x8a,0xae,0x0a,0x92,0x04,0x01,0x72,0x2a,0x16,0x29,
+    0xbc,0x4b,0x8a,0x5d,0x49,0xa7,0x49,0xb0,0xbf,0xf2,0xd7,0xe9,0x1c,0x39,0x4d,0xa0,
+    0x1e,0x40,0x8f,0x61,0x82,0xd0,0xf5,0x86,0x22,0xb3,0xe2,0xc5,0x4e,0x9c,0x36,0x65,
+    0x90,0xe8,0xe0,0xcc,0x58,0xf7,0x1b,0x44,0x1f,0xe3,0x05,0xb5,0x16,0xc1,0x37,0x53,
+    0xa1,0x26,0x09,0xc3,0x1c,0xac,0x63,0xdd,0x6e,0x51,0x32,0xf8,0x55,0x33,0xb7,0x22,
+    0xa9,0xe0,0x6d,0x80,0xb5,0x4a,0xe3,0x86,0xa3,0x7e,0x1c,0xbd,0x5b,0x60,0xdb,0x0c,
+    0xc9,0xa6,0xbc,0x53,0x17,0x70,0x41,0x7f,0xd0,0x1b,0x9b,0x1b,0x6f,0x30,0x7e,0xd5,
+    0x36,0x3d,0xb7,0xb6,0xf5,0x56,0x5f,0xbf,0xba,0xf6,0xf1,0x2b,0x40,0x4a,0xab,0xe8,
+    0x3d,0xd7,0xaa,0x57,0x49,0x48,0xcd,0xdd,0x93,0x8a,0xd6,0x63,0x9e,0x90,0x95,0xd7,
+    0x30,0x3c,0x28,0xb0,0xdd,0xc6,0x1f,0x47,0x2d,0xa7,0xd0,0xf0,0x33,0xac,0xe6,0x90,
+    0x20,0xf1,0xaa,0x74,0x41,0x6d,0x87,0xd2,0xc5,0xa8,0xbc,0x53,0x43,0xea,0x28,0x71,
+    0x53,0xdc,0x5d,0x07,0xb6,0xed,0x40,0xe9,0x0e,0xb9,0xf5,0xfc,0x00,0xa5,0x6a,0x0d,
+    0xec,0xd6,0x9a,0xb3,0x0d,0x71,0xab,0x36,0x7b,0x8b,0x0a,0xba,0xea,0x31,0x02,0xe7,
+    0x24,0x4e,0x73,0x05,0x8d,0x2c,0x32,0xb6,0xfb,0xee,0xcb,0xd7,0x9e,0xa9,0x18,0x28,
+    0xc5,0x3a,0x57,0x81,0x1a,0x3b,0xc3,0x44,0x00,0xd0,0x0b,0xf2,0xfd,0x03,0x77,0xa5,
+    0x54,0xdf,0xee,0x40,0x79,0xed,0x20,0x69,0xb1,0xff,0x13,0xec,0xaf,0xb6,0xbd,0xa7,
+    0x95,0xf6,0x12,0xc2,0x3e,0xcd,0x51,0x6d,0x77,0x01,0x19,0xee,0xda,0xbb,0x90,0x63,
+    0x0d,0x83,0xec,0x96,0xa9,0x25,0x59,0xad,0x13,0x11,0xa3,0xb8,0xf0,0xdd,0x6e,0x85,
+    0x7a,0xcf,0x0a,0xbe,0xeb,0x8a,0xd1,0x98,0x58,0xc0,0x50,0x15,0x2f,0x3a,0x1d,0xbb,
+    0xd5,0xc8,0xaf,0x52,0x39,0xab,0x77,0x7c,0xac,0xe9,0xb4,0x76,0x65,0x48,0xee,0x9f,
+    0x7e,0x67,0x93,0xc6,0x0f,0x94,0x8a,0xf8,0x72,0x13,0xa7,0x21,0x96,0x93,0x32,0x05,
+    0x12,0x1c,0x72,0x7e,0x15,0x19,0x4e,0x41,0xd2,0x42,0xc8,0xef,0x16,0x25,0x11,0xd7,
+    0x6e,0x44,0x9e,0x85,0xbc,0x86,0x6c,0x14,0x45,0x0c,0x38,0x5a,0x19,0x74,0x16,0xcc,
+    0x46,0x1c,0x77,0x4e,0x24,0x9e,0x55,0x20,0x0d,0x0f,0xd6,0xd0,0xae,0x38,0x37,0x8c,
+    0x5e,0x84,0xe9,0x55,0x8f,0x59,0x4d,0xbe,0xbf,0xdd,0x5c,0xbf,0x77,0xb0,0xd6,0x58,
+    0xdc,0x89,0x60,0x4a,0xd5,0x97,0xac,0x91,0xbb,0x33,0x07,0xb3,0x77,0xe6,0x60,0xe7,
+    0x3d,0xab,0x6a,0x50,0x2d,0xdb,0xc9,0xd4,0xeb,0x94,0x06,0x8d,0xba,0xa5,0x7f,0xf1,
+    0x01,0x2d,0x97,0x76,0x36,0x1d,0x83,0x96,0xeb,0x21,0x10,0xc2,0x33,0x0c,0xe0,0x26,
+    0xc2,0x85,0x39,0x79,0xa0,0xe2,0xb7,0xac,0xea,0x1e,0x99,0x66,0x42,0x09,0x88,0x10,
+    0xa4,0xc2,0x18,0x06,0x4f,0x79,0xc4,0x4e,0xd8,0x5c,0xca,0xa3,0xfd,0x7d,0x00,0xf2,
+    0x1c,0x7f,0xed,0x4e,0x45,0x3d,0x16,0x52,0x41,0x73,0x71,0x37,0xdf,0xec,0xb8,0xb9,
+    0x74,0x06,0x71,0x1a,0x64,0xcb,0x5b,0x9d,0x5c,0x2c,0xd0,0x35,0x9d,0xe6,0x5d,0xa6,
+    0xf7,0x84,0xee,0xa3,0x52,0xdf,0xb8,0xd5,0x0a,0x4d,0xf5,0xcc,0x5c,0x1f,0x99,0xfd,
+    0xb9,0xf4,0x1e,0x88,0x07,0x6a,0x98,0xd4,0xf3,0xeb,0xba,0xc3,0x69,0x9e,0x96,0xf5,
+    0xff,0x04,0x4a,0xc7,0x9b,0x09,0xa0,0xf1,0x7b,0x78,0xec,0x17,0xf4,0xce,0x60,0xa9,
+    0xf8,0x25,0x4f,0x47,0x6a,0xac,0x37,0xfc,0x43,0x92,0x86,0x23,0x72,0x49,0x32,0xaa,
+    0xfe,0x09,0x88,0x17,0xc5,0x40,0x5f,0x0e,0xbc,0x1b,0x69,0x3a,0xfd,0x82,0x0a,0x82,
+    0x85,0x82,0x7c,0x77,0x31,0x84,0x4f,0x71,0x03,0x11,0x9e,0xd7,0x18,0x5f,0xf4,0x35,
+    0xe3,0xcb,0x82,0x51,0x37,0x0d,0xad,0x1a,0x5a,0xd8,0x94,0x06,0xf6,0x2e,0x8b,0xa9,
+    0x34,0x77,0x0d,0x01,0x17,0x6b,0xfc,0xfa,0xf2,0x27,0x6f,0x85,0x89,0x90,0xdc,0xaf,
+    0x8d,0x7c,0x8d,0xbf,0x74,0x40,0x4b,0x72,0xbc,0xdd,0x32,0x9a,0x8d,0x3a,0xf2,0xba,
+    0x2f,0x74,0xc1,0x21,0xbd,0x9a,0x28,0x7b,0x00,0xc8,0x56,0x15,0xa4,0x99,0x22,0x6f,
+    0xae,0xaf,0xf4,0x35,0xa7,0xd7,0xa0,0x39,0xe2,0x11,0x33,0x27,0x32,0xbc,0x75,0xd0,
+    0x23,0xf5,0xbe,0x08,0xcc,0xfa,0x45,0x41,0x9d,0x1f,0x40,0xd5,0xb4,0x98,0x0e,0xe3,
+    0x73,0xf4,0x9e,0xa4,0xfb,0x83,0x58,0xd0,0x00,0x23,0xcd,0x2b,0xef,0xe2,0xb6,0xa6,
+    0xab,0x0b,0x1d,0x07,0x72,0x5d,0xe8,0x1c,0x04,0xda,0xad,0xf5,0x3c,0xdb,0x6a,0x29,
+    0x85,0xfe,0x4b,0xce,0x93,0xe4,0x4a,0xe4,0xb2,0x56,0x97,0x40,0xaa,0x02,0x9b,0xe8,
+    0x87,0x9a,0x61,0x7a,0xa6,0xdb,0x99,0xda,0x61,0xd0,0x69,0xf6,0xb3,0xdf,0xb7,0x0d,
+    0x11,0x3d,0xad,0xe8,0xea,0xbd,0xdd,0x9e,0x1d,0xf7,0xed,0xd2,0xa6,0x36,0x6c,0x93,
+    0x94,0x2d,0xad,0xe2,0xec,0x84,0xed,0xbd,0x76,0xf5,0x17,0x52,0x74,0x8f,0xbb,0xfa,
+    0xcb,0x9a,0xbd,0x85,0xa9,0x49,0xad,0x0f,0x6e,0x7d,0x77,0x67,0xfb,0xaa,0x84,0xc2,
+    0x7f,0xdd,0xd7,0xf6,0x5c,0x6a,0x6c,0xff,0x01,0xef,0x39,0xca,0x84,0xd3,0x14,0x00,
+    0x00,
+};
+
+#endif // __OmWebPagesAssets__
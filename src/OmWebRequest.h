@@ -52,7 +52,7 @@ static void inplaceRequestDecode(char *r)
 /*! Doesn't handle hex coding or quotes and stuff. */
 class OmWebRequest
 {
-    static const int kRequestLengthMax = 320;
+    static const int kRequestLengthMax = 1024; // room for a batch of /_control values
 public:
     const char *path;
     std::vector<char *> query; // vector of alternating keys & values.
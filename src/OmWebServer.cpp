@@ -4,10 +4,14 @@
  * Implementation of OmWebServer
  */
 
+#ifndef NOT_ARDUINO
 #include "Arduino.h"
+#endif
 #include "OmWebServer.h"
 #include "OmBlinker.h"
+#ifndef NOT_ARDUINO
 #include "OmUdp.h"
+#endif
 
 #ifdef ARDUINO_ARCH_ESP8266
 #include <ESP8266WiFi.h>
@@ -31,6 +35,368 @@ typedef enum
     OWS_AP_RUNNING,
 } EOwsState;
 
+/// How the body of the response in progress is delimited.
+typedef enum
+{
+    OWS_FRAMING_UNDECIDED = 0, // nothing sent yet
+    OWS_FRAMING_CLOSE, // body ends when we close the connection
+    OWS_FRAMING_LENGTH, // has a Content-Length, the handler's own, or ours if the whole response fit in one block
+    OWS_FRAMING_CHUNKED, // Transfer-Encoding: chunked, one chunk per stream block
+    OWS_FRAMING_WEBSOCKET, // on an open websocket, each stream block goes as one binary message
+} EOwsFraming;
+
+// How many browser connections we hold open at once. Each slot accumulates
+// its own request, so a slow or idle socket (like Chrome's preconnect) doesn't
+// hold up the next browser. Override with a -D define if memory is tight.
+#ifndef OMWS_CLIENT_SLOTS
+#define OMWS_CLIENT_SLOTS 4
+#endif
+
+// With every slot taken, a slot idle this long, kept alive between requests or
+// connected with nothing sent, is closed to let a waiting connection in.
+// Sooner, and it could be a preconnect about to be used, or a kept-alive
+// socket whose next request is already on the wire.
+#ifndef OMWS_IDLE_REUSE_MILLIS
+#define OMWS_IDLE_REUSE_MILLIS 1000
+#endif
+
+// Longest request line plus headers we accept, per slot. Longer is
+// refused with 414 or 431, rather than growing without limit.
+#ifndef OMWS_REQUEST_MAX
+#define OMWS_REQUEST_MAX 1024
+#endif
+#define OMWS_HEADERS_MAX 24
+
+// Browsers listening on "/_events" for value changes each hold a slot for as
+// long as the page is open. Leave the rest for ordinary requests.
+#ifndef OMWS_EVENT_STREAMS_MAX
+#define OMWS_EVENT_STREAMS_MAX (OMWS_CLIENT_SLOTS / 2)
+#endif
+#define OMWS_EVENT_HEARTBEAT 15000 // quiet event streams get a comment this often, so dead ones show up
+
+/// true if the http header in data has a Content-Length line already.
+static bool headerHasContentLength(const uint8_t *data, int size)
+{
+    static const char *name = "Content-Length:";
+    int nameLen = strlen(name);
+    for(int ix = 0; ix + nameLen <= size; ix++)
+    {
+        if((ix == 0 || data[ix - 1] == '\n') && strncasecmp((const char *)data + ix, name, nameLen) == 0)
+            return true;
+    }
+    return false;
+}
+
+/// true if the status line of the http header in data is one that never has a body:
+/// 1xx, 204 No Content and 304 Not Modified. Those mustn't get a Content-Length of
+/// their own, a 304's would be taken as the length of the cached copy.
+static bool headerStatusHasNoBody(const uint8_t *data, int size)
+{
+    if(size < 12 || strncmp((const char *)data, "HTTP/", 5) != 0)
+        return false;
+    const uint8_t *space = (const uint8_t *)memchr(data, ' ', size);
+    if(!space || space + 4 > data + size)
+        return false;
+    int status = (space[1] - '0') * 100 + (space[2] - '0') * 10 + (space[3] - '0');
+    return (status >= 100 && status < 200) || status == 204 || status == 304;
+}
+
+static bool containsNoCase(const char *s, const char *part)
+{
+    int partLen = (int)strlen(part);
+    for(; *s; s++)
+        if(strncasecmp(s, part, partLen) == 0)
+            return true;
+    return false;
+}
+
+/// true if path is exactly base, or base with a query
+static bool isPath(const char *path, const char *base)
+{
+    int baseLen = (int)strlen(base);
+    return strncmp(path, base, baseLen) == 0 && (path[baseLen] == 0 || path[baseLen] == '?');
+}
+
+/// SHA-1, only for the websocket handshake.
+static void sha1(const uint8_t *data, int size, uint8_t digest[20])
+{
+    uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+    uint64_t bits = (uint64_t)size * 8;
+    int blocks = (size + 8) / 64 + 1; // room for the 0x80 and the length
+    for(int block = 0; block < blocks; block++)
+    {
+        uint32_t w[80];
+        for(int ix = 0; ix < 64; ix++)
+        {
+            int at = block * 64 + ix;
+            uint8_t b;
+            if(at < size)
+                b = data[at];
+            else if(at == size)
+                b = 0x80;
+            else if(block == blocks - 1 && ix >= 56)
+                b = (uint8_t)(bits >> (8 * (63 - ix)));
+            else
+                b = 0;
+            if((ix & 3) == 0)
+                w[ix / 4] = 0;
+            w[ix / 4] |= (uint32_t)b << (8 * (3 - (ix & 3)));
+        }
+        for(int ix = 16; ix < 80; ix++)
+        {
+            uint32_t x = w[ix - 3] ^ w[ix - 8] ^ w[ix - 14] ^ w[ix - 16];
+            w[ix] = (x << 1) | (x >> 31);
+        }
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+        for(int ix = 0; ix < 80; ix++)
+        {
+            uint32_t f, k;
+            if(ix < 20) { f = (b & c) | (~b & d); k = 0x5A827999; }
+            else if(ix < 40) { f = b ^ c ^ d; k = 0x6ED9EBA1; }
+            else if(ix < 60) { f = (b & c) | (b & d) | (c & d); k = 0x8F1BBCDC; }
+            else { f = b ^ c ^ d; k = 0xCA62C1D6; }
+            uint32_t t = ((a << 5) | (a >> 27)) + f + e + k + w[ix];
+            e = d;
+            d = c;
+            c = (b << 30) | (b >> 2);
+            b = a;
+            a = t;
+        }
+        h[0] += a; h[1] += b; h[2] += c; h[3] += d; h[4] += e;
+    }
+    for(int ix = 0; ix < 20; ix++)
+        digest[ix] = (uint8_t)(h[ix / 4] >> (8 * (3 - (ix & 3))));
+}
+
+/// base64 of size bytes into out, zero terminated. out needs (size + 2) / 3 * 4 + 1.
+static void base64(const uint8_t *data, int size, char *out)
+{
+    static const char *digits = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    for(int ix = 0; ix < size; ix += 3)
+    {
+        uint32_t x = (uint32_t)data[ix] << 16;
+        if(ix + 1 < size) x |= (uint32_t)data[ix + 1] << 8;
+        if(ix + 2 < size) x |= data[ix + 2];
+        *out++ = digits[(x >> 18) & 63];
+        *out++ = digits[(x >> 12) & 63];
+        *out++ = ix + 1 < size ? digits[(x >> 6) & 63] : '=';
+        *out++ = ix + 2 < size ? digits[x & 63] : '=';
+    }
+    *out = 0;
+}
+
+/// Accumulates one http request in a fixed buffer, as bytes arrive, and
+/// picks it apart in place once the blank line after the headers shows up.
+class OmHttpRequestParser
+{
+public:
+    char buffer[OMWS_REQUEST_MAX + 1];
+    int length = 0; // bytes in buffer
+    int scanned = 0; // bytes checked for the end of the headers
+    int crlfMatched = 0; // how much of "\r\n\r\n" we've just seen
+    bool sawLineEnd = false; // so we know if it's the request line or the headers that are too long
+    int headerEnd = 0; // once complete, bytes past here belong to the next request (or a body)
+    bool complete = false;
+    int errorStatus = 0; // 414 or 431 if it got too big
+    uint32_t parseTicks = 0; // omTicks() spent finding and parsing the headers, for "_perf"
+
+    const char *method = "";
+    const char *path = "";
+    const char *version = "";
+    int headerCount = 0;
+    const char *headerNames[OMWS_HEADERS_MAX];
+    const char *headerValues[OMWS_HEADERS_MAX];
+
+    void reset()
+    {
+        this->length = 0;
+        this->startOver();
+    }
+
+    /// where to read more bytes into, and how many fit.
+    char *readHere() { return this->buffer + this->length; }
+    int room() { return OMWS_REQUEST_MAX - this->length; }
+
+    /// k more bytes were read into readHere(). Watch for the end of the headers.
+    void took(int k)
+    {
+        uint32_t t0 = omTicks();
+        this->length += k;
+        while(!this->complete && this->scanned < this->length)
+        {
+            char c = this->buffer[this->scanned++];
+            if(c == '\n')
+                this->sawLineEnd = true;
+            // match \r\n\r\n, as bytes arrive.
+            if(c == ((this->crlfMatched & 1) ? '\n' : '\r'))
+                this->crlfMatched++;
+            else
+                this->crlfMatched = (c == '\r') ? 1 : 0;
+            if(this->crlfMatched == 4)
+            {
+                this->headerEnd = this->scanned;
+                this->complete = true;
+                this->parse();
+            }
+        }
+        if(!this->complete && this->length >= OMWS_REQUEST_MAX)
+            this->errorStatus = this->sawLineEnd ? 431 : 414;
+        this->parseTicks += omTicks() - t0;
+    }
+
+    /// The connection is now a websocket. Keep any bytes after the headers;
+    /// from here on the buffer is just raw incoming bytes, filled by raw().
+    void switchToRaw()
+    {
+        int leftover = this->length - this->headerEnd;
+        if(leftover > 0)
+            memmove(this->buffer, this->buffer + this->headerEnd, leftover);
+        this->startOver();
+        this->length = leftover > 0 ? leftover : 0;
+    }
+
+    /// k more raw bytes were read into readHere()
+    void raw(int k) { this->length += k; }
+
+    /// done with the first k raw bytes
+    void dropRaw(int k)
+    {
+        this->length -= k;
+        memmove(this->buffer, this->buffer + k, this->length);
+    }
+
+    /// Done with this request; keep any bytes after it, they're the next one.
+    void nextRequest()
+    {
+        int leftover = this->length - this->headerEnd;
+        if(leftover > 0)
+            memmove(this->buffer, this->buffer + this->headerEnd, leftover);
+        this->length = 0;
+        this->startOver();
+        this->took(leftover > 0 ? leftover : 0);
+    }
+
+    /// case-insensitive header lookup, or NULL
+    const char *getHeader(const char *name)
+    {
+        for(int ix = 0; ix < this->headerCount; ix++)
+            if(strcasecmp(name, this->headerNames[ix]) == 0)
+                return this->headerValues[ix];
+        return NULL;
+    }
+
+    /// HTTP/1.1, so it can take a chunked body. An HTTP/1.0 client can't.
+    bool isHttp11()
+    {
+        return strcmp(this->version, "HTTP/1.1") == 0;
+    }
+
+    /// true if the client will accept another request on this connection.
+    /// HTTP/1.1 is persistent unless it says close, HTTP/1.0 only if it asks.
+    bool wantsKeepAlive()
+    {
+        const char *connection = this->getHeader("Connection");
+        if(connection && containsNoCase(connection, "close"))
+            return false;
+        if(connection && containsNoCase(connection, "keep-alive"))
+            return true;
+        return this->isHttp11();
+    }
+
+private:
+    void startOver()
+    {
+        this->scanned = 0;
+        this->crlfMatched = 0;
+        this->sawLineEnd = false;
+        this->headerEnd = 0;
+        this->complete = false;
+        this->errorStatus = 0;
+        this->parseTicks = 0;
+        this->method = "";
+        this->path = "";
+        this->version = "";
+        this->headerCount = 0;
+    }
+
+    static char *skipTo(char *w, char *end, char stopAt)
+    {
+        while(w < end && *w != stopAt)
+            w++;
+        return w;
+    }
+
+    /// Break the request line and headers into strings, right in the buffer.
+    void parse()
+    {
+        char *w = this->buffer;
+        char *end = this->buffer + this->headerEnd;
+
+        // GET /path?query HTTP/1.1
+        char *lineEnd = skipTo(w, end, '\r');
+        *lineEnd = 0;
+        this->method = w;
+        w = skipTo(w, lineEnd, ' ');
+        if(w < lineEnd)
+        {
+            *w++ = 0;
+            this->path = w;
+            w = skipTo(w, lineEnd, ' ');
+            if(w < lineEnd)
+            {
+                *w++ = 0;
+                this->version = w;
+            }
+        }
+
+        // Name: value
+        w = lineEnd + 2;
+        while(w < end && *w != '\r' && this->headerCount < OMWS_HEADERS_MAX)
+        {
+            lineEnd = skipTo(w, end, '\r');
+            *lineEnd = 0;
+            char *colon = skipTo(w, lineEnd, ':');
+            if(colon < lineEnd)
+            {
+                *colon++ = 0;
+                while(*colon == ' ')
+                    colon++;
+                this->headerNames[this->headerCount] = w;
+                this->headerValues[this->headerCount] = colon;
+                this->headerCount++;
+            }
+            w = lineEnd + 2;
+        }
+    }
+};
+
+/// One open connection, and the request arriving on it.
+class OmWebServerClientSlot
+{
+public:
+    WiFiClient client;
+    long long startMillis = 0; // when connected, or when the last response finished on a kept-alive connection
+    int requestsServed = 0;
+    OmHttpRequestParser request;
+    bool eventStream = false; // held open, pushing value changes from OmWebPages
+    bool webSocket = false; // and it's a websocket, taking value changes in too
+    uint32_t eventSerial = 0; // value serial this event stream is up to
+
+    bool isOpen()
+    {
+        return this->client && this->client.connected();
+    }
+
+    void close()
+    {
+        this->client.stop();
+        this->request.reset();
+        this->requestsServed = 0;
+        this->eventStream = false;
+        this->webSocket = false;
+    }
+};
+
 /// This class reduces clutter in the public header file.
 class OmWebServerPrivates
 {
@@ -56,6 +422,17 @@ public:
     uint8_t streamBlock[STREAM_BLOCK + 1];
     int streamBlockIndex = 0;
     int streamCount = 0;
+    bool streamKeepAlive = false; // this response may be framed so the connection can stay open
+    bool streamChunked = false; // and the request was HTTP/1.1, so that framing may be chunked
+    EOwsFraming streamFraming = OWS_FRAMING_UNDECIDED;
+    int streamNewlines = 0; // consecutive line ends seen, while looking for the end of the http header
+    int streamBodyStart = -1; // index in streamBlock just past the http header, once found
+    uint32_t streamStallTicks = 0; // omTicks() spent blocked in the client's write, this response
+    int streamWriteErrors = 0; // writes the client didn't take all of
+
+    int keepAliveIdleMillis = 0; // 0 means close every connection after one response
+    int keepAliveMaxRequests = 0;
+    bool webSocketEnabled = false;
 
     int lastWifiStatus = -99;
     
@@ -67,10 +444,10 @@ public:
     long lastMillis;
     long long uptimeMillis;
 
-    // connection in progress...
-    WiFiClient client;
-    long long clientStartMillis = 0;
-    String request;
+    // connections in progress...
+    OmWebServerClientSlot clientSlots[OMWS_CLIENT_SLOTS];
+    int clientSlotNext = 0; // round robin, so no slot gets starved
+    WiFiClient *streamClient = 0; // the client we're answering right now
 
     bool accessPoint = false; // set to true if an access point is actually running.
     String accessPointSsid;
@@ -98,6 +475,148 @@ public:
         int tH = (t / 10) % 100;
         OMLOG("%4d.%02d (*) OmWebServer.%d: %s", tS, tH, this->port, s);
     }
+
+    /// Point the put() stream at this client, for one response.
+    void beginStream(WiFiClient *client, bool keepAlive, bool chunked)
+    {
+        this->streamToClient = true; // streaming available!
+        this->streamClient = client;
+        this->streamBlockIndex = 0;
+        this->streamCount = 0;
+        this->streamKeepAlive = keepAlive;
+        this->streamChunked = chunked;
+        this->streamFraming = OWS_FRAMING_UNDECIDED;
+        this->streamNewlines = 0;
+        this->streamBodyStart = -1;
+        this->streamStallTicks = 0;
+        this->streamWriteErrors = 0;
+    }
+
+    void endStream()
+    {
+        this->streamToClient = false;
+        this->streamClient = 0;
+    }
+
+    /// true if every slot is open and another connection is waiting for one.
+    bool clientWaiting()
+    {
+        for(int ix = 0; ix < OMWS_CLIENT_SLOTS; ix++)
+            if(!this->clientSlots[ix].isOpen())
+                return false;
+        return this->wifiServer->hasClient();
+    }
+
+    /// Refuse another event stream or websocket if they already hold their share of the slots.
+    bool eventStreamsFull(OmWebServerClientSlot &slot)
+    {
+        int eventStreams = 0;
+        for(int ix = 0; ix < OMWS_CLIENT_SLOTS; ix++)
+            if(this->clientSlots[ix].eventStream)
+                eventStreams++;
+        if(eventStreams < OMWS_EVENT_STREAMS_MAX)
+            return false;
+
+        // The browser won't retry after an error status, so this page
+        // just doesn't get live values.
+        const char *response = "HTTP/1.1 503 Service Unavailable\r\nConnection: close\r\nContent-Length: 0\r\n\r\n";
+        slot.client.write((const uint8_t *)response, strlen(response));
+        slot.close();
+        return true;
+    }
+
+    void streamWrite(const void *data, int size)
+    {
+        if(size <= 0)
+            return;
+        uint32_t t0 = omTicks();
+        if((int)this->streamClient->write((const uint8_t *)data, size) < size)
+            this->streamWriteErrors++;
+        this->streamStallTicks += omTicks() - t0;
+    }
+
+    /// Send the stream block on to the client. The first send decides how the
+    /// body is delimited: the handler's Content-Length if it gave one; if not,
+    /// and this is also the last, ours; if not, chunked, with every later block
+    /// becoming one chunk. Our framing header gets slipped in just before the
+    /// header's blank line. A status with no body, like 304, is delimited by
+    /// the header alone. An HTTP/1.0 client can't read chunks, so for it
+    /// only the handler's own length or a bodiless status keep the connection;
+    /// otherwise the body ends when we close.
+    void flushStream(bool last)
+    {
+        uint8_t *data = this->streamBlock;
+        int size = this->streamBlockIndex;
+        this->streamBlockIndex = 0;
+        if(!this->streamClient)
+            return;
+
+        if(this->streamFraming == OWS_FRAMING_UNDECIDED)
+        {
+            if(this->streamKeepAlive && this->streamBodyStart >= 0
+               && (headerHasContentLength(data, this->streamBodyStart) || headerStatusHasNoBody(data, this->streamBodyStart)))
+                this->streamFraming = OWS_FRAMING_LENGTH;
+            else if(this->streamKeepAlive && this->streamChunked && this->streamBodyStart >= 0)
+            {
+                // the blank line is just before the body, "\n" or "\r\n".
+                int headerEnd = this->streamBodyStart - 1;
+                if(headerEnd > 0 && data[headerEnd - 1] == '\r')
+                    headerEnd--;
+                char framingHeader[40];
+                int k;
+                if(last)
+                {
+                    this->streamFraming = OWS_FRAMING_LENGTH;
+                    k = snprintf(framingHeader, sizeof(framingHeader), "Content-Length: %d\n", size - this->streamBodyStart);
+                }
+                else
+                {
+                    this->streamFraming = OWS_FRAMING_CHUNKED;
+                    k = snprintf(framingHeader, sizeof(framingHeader), "Transfer-Encoding: chunked\n");
+                }
+                this->streamWrite(data, headerEnd);
+                this->streamWrite(framingHeader, k);
+                this->streamWrite(data + headerEnd, this->streamBodyStart - headerEnd);
+                data += this->streamBodyStart;
+                size -= this->streamBodyStart;
+            }
+            else
+                this->streamFraming = OWS_FRAMING_CLOSE;
+        }
+
+        if(this->streamFraming == OWS_FRAMING_WEBSOCKET)
+        {
+            if(size > 0)
+            {
+                // unmasked binary message, FIN set. STREAM_BLOCK always fits a 16 bit length.
+                uint8_t frameHeader[4] = {0x82, (uint8_t)size};
+                int k = 2;
+                if(size > 125)
+                {
+                    frameHeader[1] = 126;
+                    frameHeader[2] = (uint8_t)(size >> 8);
+                    frameHeader[3] = (uint8_t)size;
+                    k = 4;
+                }
+                this->streamWrite(frameHeader, k);
+                this->streamWrite(data, size);
+            }
+        }
+        else if(this->streamFraming == OWS_FRAMING_CHUNKED)
+        {
+            char chunkSize[12];
+            if(size > 0)
+            {
+                this->streamWrite(chunkSize, snprintf(chunkSize, sizeof(chunkSize), "%x\r\n", size));
+                this->streamWrite(data, size);
+                this->streamWrite("\r\n", 2);
+            }
+            if(last)
+                this->streamWrite("0\r\n\r\n", 5);
+        }
+        else
+            this->streamWrite(data, size);
+    }
 };
 
 static OmWebServer *recentOmWebServer = 0; // dumbest trick ever, so plain-C callbacks can access. :-/
@@ -206,6 +725,7 @@ void OmWebServer::maybeStatusCallback(bool trying, bool failure, bool success)
     }
 
     // tell any UDP handlers
+#ifndef NOT_ARDUINO
     {
         OMLOG("udp handler wifi update");
         OmUdp *udp = OmUdp::first;
@@ -216,6 +736,7 @@ void OmWebServer::maybeStatusCallback(bool trying, bool failure, bool success)
             udp = udp->next;
         }
     }
+#endif
     
     if(this->p->statusCallback)
     {
@@ -328,38 +849,6 @@ void OmWebServer::glitch(int k)
 
 }
 
-static bool endsWithCrlfCrlf(String &s)
-{
-  int len = (int)s.length();
-  if(len < 4)
-    return false;
-  if(s[len-4] == 13 && s[len-3] == 10 && s[len-2] == 13 && s[len-1] == 10)
-    return true;
-  return false;
-}
-
-static String urlFromRequest(String r)
-{
-  String url;
-  int len = (int)r.length();
-  int ix = 0;
-  bool firstSp = false;
-  while(ix < len)
-  {
-    char c = r[ix++];
-    if(c == ' ')
-    {
-      if(firstSp)
-        return url;
-      else
-        firstSp = true;
-    }
-    else if(firstSp)
-      url += c;
-  }
-  return url;
-}
-
 /*
  Handy cheat sheet
  typedef enum {
@@ -396,52 +885,142 @@ int OmWebServer::pollForClient()
 
     // do our funny polling.
 
-    // maybe kill an open client if it's been a little while
-    // You see, this library only manages a single open client at a time. We only ask
-    // for a client when the last one we got is no longer active.
-    // but Chrome (for example) opens a connection immediately, to make the next
-    // action snappier to the user. So here, we just shut that down. Chrome spots it,
-    // and initiates a fresh connection _WHEN the TIME comes_.
+    // We keep a small pool of open clients. Each one gets a deadline; a client that
+    // hasn't finished a request by then gets closed. Chrome (for example) opens a
+    // connection immediately, to make the next action snappier to the user. That
+    // used to block everyone else, with only a single client. Now it just sits in
+    // its own slot until its deadline, and Chrome initiates a fresh connection
+    // _WHEN the TIME comes_. With only one client, the deadline had to be short
+    // (it was 300ms) to get the next browser in. In its own slot, a client can
+    // be given the time a slow link needs to get a whole request across.
 
     if(this->p->dns)
         this->p->dns->processNextRequest();
     int result = 0;
-#define CLIENT_DEADLINE 300
-    if(this->p->client || this->p->client.connected())
+#define CLIENT_DEADLINE 2000
+    for(int ix = 0; ix < OMWS_CLIENT_SLOTS; ix++)
     {
-        if(this->p->uptimeMillis - this->p->clientStartMillis > CLIENT_DEADLINE)
+        OmWebServerClientSlot &slot = this->p->clientSlots[ix];
+        if(slot.eventStream)
+        {
+            // event streams stay until the browser goes away
+            if(!slot.client.connected())
+                slot.close();
+        }
+        else if(slot.client || slot.client.connected())
         {
-            this->p->client.stop();
+            // a kept-alive connection gets the idle timeout between requests
+            int deadline = slot.requestsServed ? this->p->keepAliveIdleMillis : CLIENT_DEADLINE;
+            if(this->p->uptimeMillis - slot.startMillis > deadline)
+                slot.close();
         }
     }
 
-    if(!this->p->client || !this->p->client.connected())
+    // take in any newly arrived client. If every slot is busy, the oldest one idle for
+    // OMWS_IDLE_REUSE_MILLIS makes room: kept alive between requests, or connected with
+    // nothing sent yet. Otherwise the newcomer waits in the accept backlog, and the next
+    // response on a kept-alive slot says "Connection: close" and gives the slot up.
+    OmWebServerClientSlot *newSlot = 0;
+    for(int ix = 0; ix < OMWS_CLIENT_SLOTS; ix++)
     {
-        this->p->client = this->p->wifiServer->available();
-        if(this->p->client.connected())
+        OmWebServerClientSlot &aSlot = this->p->clientSlots[ix];
+        if(!aSlot.isOpen())
         {
-            this->p->request = "";
-            this->p->clientStartMillis = this->p->uptimeMillis;
-            this->p->accessPointStartMillis = this->p->clientStartMillis; // keep the AP mode alive longer, it is in use.
+            newSlot = &aSlot;
+            break;
         }
+        bool idle = !aSlot.eventStream && aSlot.request.length == 0 && !aSlot.client.available()
+            && this->p->uptimeMillis - aSlot.startMillis >= OMWS_IDLE_REUSE_MILLIS;
+        if(idle && (!newSlot || aSlot.startMillis < newSlot->startMillis))
+            newSlot = &aSlot;
+    }
+    WiFiClient newClient;
+    if(newSlot)
+        newClient = this->p->wifiServer->available();
+    if(newClient.connected())
+    {
+        newSlot->close();
+        newSlot->client = newClient;
+        newSlot->startMillis = this->p->uptimeMillis;
+        if(this->p->keepAliveIdleMillis)
+            newSlot->client.setNoDelay(true); // small responses on a reused socket shouldnt wait for Nagle
+        this->p->accessPointStartMillis = newSlot->startMillis; // keep the AP mode alive longer, it is in use.
     }
 
-    if(this->p->client && this->p->client.connected())
+    // and give each open client a turn, starting at a different one each tick.
+    int first = this->p->clientSlotNext;
+    this->p->clientSlotNext = (first + 1) % OMWS_CLIENT_SLOTS;
+    for(int k = 0; k < OMWS_CLIENT_SLOTS; k++)
     {
-        while(this->p->client.available())
+        OmWebServerClientSlot &slot = this->p->clientSlots[(first + k) % OMWS_CLIENT_SLOTS];
+        if(!slot.isOpen())
+            continue;
+        if(slot.eventStream)
+        {
+            this->serviceEventStream(slot);
+            continue;
+        }
+        while(slot.isOpen())
         {
-            char c = this->p->client.read();
-            // Serial.printf("%c", c); // excrutiating verbose
-            // TODO: limit the size of this activity. Easy to intentionally crash this with a big request.
-            this->p->request += c;
-            if(endsWithCrlfCrlf(this->p->request))
+            OmHttpRequestParser &request = slot.request;
+            if(!request.complete && !request.errorStatus)
+            {
+                // read what's arrived, as much as fits.
+                int k = slot.client.available();
+                if(k <= 0)
+                    break;
+                if(k > request.room())
+                    k = request.room();
+                k = slot.client.read((uint8_t *)request.readHere(), k);
+                if(k <= 0)
+                    break;
+                request.took(k);
+            }
+
+            if(request.errorStatus)
             {
-                // looks like the request finished. Ok, so:
-                String url = urlFromRequest(this->p->request);
+                this->p->printf("Request too large, replying %d", request.errorStatus);
+                const char *response = request.errorStatus == 414
+                    ? "HTTP/1.1 414 URI Too Long\r\nConnection: close\r\nContent-Length: 0\r\n\r\n"
+                    : "HTTP/1.1 431 Request Header Fields Too Large\r\nConnection: close\r\nContent-Length: 0\r\n\r\n";
+                slot.client.write((const uint8_t *)response, strlen(response));
+                slot.close();
+                break;
+            }
+
+            if(!request.complete)
+                continue;
+
+            // looks like the request finished. Ok, so: whether the client wants the
+            // connection kept. Whether it is also depends on the framing it can read;
+            // an HTTP/1.0 client gets no chunks, so handleRequest() says after.
+            bool keepAlive = this->p->keepAliveIdleMillis > 0
+                && slot.requestsServed + 1 < this->p->keepAliveMaxRequests
+                && request.wantsKeepAlive()
+                && !this->p->clientWaiting();
 
-                result++;
-                this->handleRequest(url, this->p->client); // performs the SEND.
+            result++;
+            if(this->p->requestHandlerPages && isPath(request.path, "/_events"))
+            {
+                this->beginEventStream(slot);
+                break;
+            }
+            if(this->p->requestHandlerPages && this->p->webSocketEnabled && isPath(request.path, "/_ws"))
+            {
+                if(this->beginWebSocket(slot))
+                    this->beginEventStream(slot);
+                break;
             }
+            keepAlive = this->handleRequest(request, slot.client, keepAlive); // performs the SEND.
+            if(!keepAlive)
+            {
+                slot.close();
+                break;
+            }
+            // same client may send another; the idle clock starts now.
+            slot.requestsServed++;
+            slot.request.nextRequest();
+            slot.startMillis = this->p->uptimeMillis;
         }
     }
     return result;
@@ -693,11 +1272,22 @@ bool OmWebServer::put(uint8_t ch)
     {
         this->p->streamCount++;
         this->p->streamBlock[this->p->streamBlockIndex++] = ch;
-        if(this->p->streamBlockIndex == STREAM_BLOCK)
+
+        // Note where the http header ends (the first empty line), so the first
+        // flush can add a Content-Length or chunked framing header.
+        if(this->p->streamBodyStart < 0 && this->p->streamFraming == OWS_FRAMING_UNDECIDED)
         {
-            this->p->client.write(this->p->streamBlock, this->p->streamBlockIndex);
-            this->p->streamBlockIndex = 0;
+            if(ch == '\n')
+            {
+                if(++this->p->streamNewlines == 2)
+                    this->p->streamBodyStart = this->p->streamBlockIndex;
+            }
+            else if(ch != '\r')
+                this->p->streamNewlines = 0;
         }
+
+        if(this->p->streamBlockIndex == STREAM_BLOCK)
+            this->p->flushStream(false);
     }
     else
         result = false;
@@ -707,49 +1297,70 @@ bool OmWebServer::put(uint8_t ch)
 
 bool OmWebServer::put(const char *s)
 {
-    bool result = true;
-    while(*s)
-        result &= this->put(*s++);
-    return result;
+    return this->putS(s);
 }
+
 bool OmWebServer::put(uint8_t *d, int size)
 {
-    bool result = true;
-    while(size-- > 0)
-        result &= this->put(*d++);
-    return result;
+    return this->putN(d, size);
 }
 
+bool OmWebServer::putN(const uint8_t *data, size_t size)
+{
+    if(!this->p->streamToClient)
+        return false;
+
+    // Until the header's end is found, bytes go through put() which watches for it.
+    while(size > 0 && this->p->streamBodyStart < 0 && this->p->streamFraming == OWS_FRAMING_UNDECIDED)
+    {
+        this->put(*data++);
+        size--;
+    }
+
+    // the rest, a block at a time.
+    while(size > 0)
+    {
+        size_t room = STREAM_BLOCK - this->p->streamBlockIndex;
+        size_t k = size < room ? size : room;
+        memcpy(this->p->streamBlock + this->p->streamBlockIndex, data, k);
+        this->p->streamBlockIndex += k;
+        this->p->streamCount += k;
+        data += k;
+        size -= k;
+        if(this->p->streamBlockIndex == STREAM_BLOCK)
+            this->p->flushStream(false);
+    }
+    return true;
+}
 
 bool OmWebServer::done()
 {
-    this->p->client.write(this->p->streamBlock, this->p->streamBlockIndex);
-    this->p->streamBlockIndex = 0;
+    // Just a flush; the response isn't over until handleRequest says so.
+    // (A bitmap streamer, for one, calls done() when its pixels are finished.)
+    this->p->flushStream(false);
     return true;
 }
 
-void OmWebServer::handleRequest(String request, WiFiClient &client)
+bool OmWebServer::handleRequest(OmHttpRequestParser &httpRequest, WiFiClient &client, bool keepAlive)
 {
+    const char *request = httpRequest.path;
+
     // TODO: this could be on OmWebServerPrivates, to hide fully.
     this->p->requestCount++;
     this->p->b.addInterjection(2,2); // blink LED to show incoming
 
 
-    String uriS = request;
-    
     int remotePort = client.remotePort();
     IPAddress remoteIp = client.remoteIP();
     if(this->p->verbose >= 2)
     {
         // but we never save to the in-memory online log. so.
         bool wasE = OmLog.setBufferEnabled(false);
-        this->p->printf("Request from %s:%d %s", omIpToString(remoteIp, true), remotePort, uriS.c_str());
+        this->p->printf("Request from %s:%d %s", omIpToString(remoteIp, true), remotePort, request);
         OmLog.setBufferEnabled(wasE);
     }
 
-    this->p->streamToClient = true; // streaming available!
-    this->p->streamBlockIndex = 0;
-    this->p->streamCount = 0;
+    this->p->beginStream(&client, keepAlive, httpRequest.isHttp11());
 
     if(this->p->requestHandler)
     {
@@ -757,12 +1368,14 @@ void OmWebServer::handleRequest(String request, WiFiClient &client)
         // determine the response code & type. should let it stream, not
         // require a const char * return.
         // TODO reconsider. dvb2019-11
+        const char *response = (this->p->requestHandler)(request);
+        char contentLength[32];
+        snprintf(contentLength, sizeof(contentLength), "Content-Length: %d\n", (int)strlen(response));
         this->put("HTTP/1.1 200 OK\n"
-                  "Content-type:text/html\n"
-                  "Connection: close\n"
-                  "\n");
-
-        const char *response = (this->p->requestHandler)(uriS.c_str());
+                  "Content-type:text/html\n");
+        this->put(keepAlive ? "Connection: keep-alive\n" : "Connection: close\n");
+        this->put(contentLength);
+        this->put("\n");
         this->put(response);
     }
     else if(this->p->requestHandlerPages)
@@ -774,13 +1387,23 @@ void OmWebServer::handleRequest(String request, WiFiClient &client)
         ri.serverPort = this->getPort();
         ri.bonjourName = this->p->bonjourName.c_str();
         ri.uptimeMillis = this->p->uptimeMillis;
+        ri.keepAlive = keepAlive;
+        ri.chunked = httpRequest.isHttp11();
+        ri.webSocket = this->p->webSocketEnabled;
+        ri.parseTicks = httpRequest.parseTicks;
+        const char *ifNoneMatch = httpRequest.getHeader("If-None-Match");
+        if(ifNoneMatch)
+            ri.ifNoneMatch = ifNoneMatch;
+        const char *acceptEncoding = httpRequest.getHeader("Accept-Encoding");
+        if(acceptEncoding)
+            ri.acceptEncoding = acceptEncoding;
         if(this->p->accessPoint)
             ri.ap = this->p->accessPointSsid.c_str();
         else
             ri.ssid = this->getSsid();
 
         // callee needs to render the response header, content type, 200, &c.
-        this->p->requestHandlerPages->handleRequest(this, uriS.c_str(), &ri); // first "this" is us as an OmIByteStream.
+        this->p->requestHandlerPages->handleRequest(this, request, &ri); // first "this" is us as an OmIByteStream.
     }
     else
     {
@@ -795,15 +1418,236 @@ void OmWebServer::handleRequest(String request, WiFiClient &client)
         this->put("</pre>\n");
     }
 
-    this->done(); // flush the stream.
-    client.stop();
-    this->p->streamToClient = false;
+    // flush the stream. If it couldn't be framed, closing is how it ends.
+    this->p->flushStream(true);
+    if(this->p->requestHandlerPages && !this->p->requestHandler)
+        this->p->requestHandlerPages->requestFinished(this->p->streamStallTicks, this->p->streamWriteErrors == 0);
+    keepAlive = this->p->streamFraming == OWS_FRAMING_LENGTH || this->p->streamFraming == OWS_FRAMING_CHUNKED;
+    if(!keepAlive)
+        client.stop();
+    this->p->endStream();
     if(this->p->verbose >= 2)
     {
         bool wasE = OmLog.setBufferEnabled(false);
-        this->p->printf("Replying %d bytes", this->p->streamCount);
+        this->p->printf("Replying %d bytes%s", this->p->streamCount, keepAlive ? ", keep-alive" : "");
         OmLog.setBufferEnabled(wasE);
     }
+    return keepAlive;
+}
+
+/// Answer "/_events" with a Server-Sent Events stream, and keep the slot for it.
+/// (Or, after beginWebSocket, set up the websocket's outgoing values the same way.)
+void OmWebServer::beginEventStream(OmWebServerClientSlot &slot)
+{
+    this->p->requestCount++;
+    if(this->p->eventStreamsFull(slot))
+        return;
+
+    // Pick up where the page was rendered, or where a dropped stream left off.
+    uint32_t serial = this->p->requestHandlerPages->getValueSerial();
+    const char *since = slot.request.getHeader("Last-Event-ID");
+    if(!since)
+    {
+        since = strstr(slot.request.path, "since=");
+        if(since)
+            since += 6;
+    }
+    slot.eventSerial = since ? (uint32_t)strtoul(since, NULL, 10) : serial;
+    if(slot.eventSerial > serial)
+        slot.eventSerial = serial; // from before a reboot
+
+    if(this->p->verbose >= 2)
+    {
+        bool wasE = OmLog.setBufferEnabled(false);
+        this->p->printf("%s to %s:%d", slot.webSocket ? "Websocket" : "Event stream",
+                        omIpToString(slot.client.remoteIP(), true), slot.client.remotePort());
+        OmLog.setBufferEnabled(wasE);
+    }
+
+    if(slot.webSocket)
+        slot.request.switchToRaw(); // the handshake already went out
+    else
+    {
+        const char *header = "HTTP/1.1 200 OK\r\n"
+            "Content-Type: text/event-stream\r\n"
+            "Cache-Control: no-cache\r\n"
+            "Access-Control-Allow-Origin: *\r\n"
+            "\r\n"
+            "retry: 3000\n\n";
+        slot.client.write((const uint8_t *)header, strlen(header));
+        slot.request.reset();
+    }
+    slot.eventStream = true;
+    slot.startMillis = this->p->uptimeMillis;
+}
+
+/// Answer the websocket upgrade on "/_ws". If it's not a proper one, refuse and close.
+bool OmWebServer::beginWebSocket(OmWebServerClientSlot &slot)
+{
+    if(this->p->eventStreamsFull(slot))
+        return false;
+
+    const char *upgrade = slot.request.getHeader("Upgrade");
+    const char *key = slot.request.getHeader("Sec-WebSocket-Key");
+    if(!upgrade || !containsNoCase(upgrade, "websocket") || !key || strlen(key) > 40)
+    {
+        const char *response = "HTTP/1.1 400 Bad Request\r\nConnection: close\r\nContent-Length: 0\r\n\r\n";
+        slot.client.write((const uint8_t *)response, strlen(response));
+        slot.close();
+        return false;
+    }
+
+    // The accept key proves we read theirs: base64(sha1(key + the protocol's magic guid)).
+    char keyAndGuid[80];
+    int k = snprintf(keyAndGuid, sizeof(keyAndGuid), "%s258EAFA5-E914-47DA-95CA-C5AB0DC85B11", key);
+    uint8_t digest[20];
+    sha1((const uint8_t *)keyAndGuid, k, digest);
+    char accept[32];
+    base64(digest, sizeof(digest), accept);
+
+    char response[160];
+    k = snprintf(response, sizeof(response), "HTTP/1.1 101 Switching Protocols\r\n"
+                 "Upgrade: websocket\r\n"
+                 "Connection: Upgrade\r\n"
+                 "Sec-WebSocket-Accept: %s\r\n"
+                 "\r\n", accept);
+    slot.client.write((const uint8_t *)response, k);
+    slot.client.setNoDelay(true); // small frames, both ways
+    slot.webSocket = true;
+    return true;
+}
+
+/// Take in whatever websocket frames have arrived: value records, pings, close.
+void OmWebServer::serviceWebSocketInput(OmWebServerClientSlot &slot)
+{
+    OmHttpRequestParser &in = slot.request;
+    int k = slot.client.available();
+    if(k > in.room())
+        k = in.room();
+    if(k > 0)
+    {
+        k = slot.client.read((uint8_t *)in.readHere(), k);
+        if(k > 0)
+            in.raw(k);
+    }
+
+    while(in.length >= 2)
+    {
+        uint8_t *frame = (uint8_t *)in.buffer;
+        bool fin = (frame[0] & 0x80) != 0;
+        int opcode = frame[0] & 0x0f;
+        int size = frame[1] & 0x7f;
+        int at = 2;
+        if(size == 126)
+        {
+            if(in.length < 4)
+                break;
+            size = (frame[2] << 8) | frame[3];
+            at = 4;
+        }
+        if(size == 127 || !(frame[1] & 0x80) || at + 4 + size > OMWS_REQUEST_MAX)
+        {
+            // too big for us, or not masked like a browser's must be. Say so and hang up.
+            const uint8_t closeFrame[4] = {0x88, 0x02, 0x03, 0xf1}; // 1009, message too big
+            slot.client.write(closeFrame, sizeof(closeFrame));
+            slot.close();
+            return;
+        }
+        if(in.length < at + 4 + size)
+            break; // rest of it hasn't arrived yet
+        if(opcode == 0x0 || (!fin && opcode < 0x8))
+        {
+            // A message in pieces. Ours are 8 byte records, a browser has no
+            // reason to split them, so we don't put them back together.
+            const uint8_t closeFrame[4] = {0x88, 0x02, 0x03, 0xeb}; // 1003, can't accept it
+            slot.client.write(closeFrame, sizeof(closeFrame));
+            slot.close();
+            return;
+        }
+
+        uint8_t *mask = frame + at;
+        uint8_t *payload = mask + 4;
+        for(int ix = 0; ix < size; ix++)
+            payload[ix] ^= mask[ix & 3];
+
+        switch(opcode)
+        {
+            case 0x2: // binary: value records, page item value
+                this->p->requestCount++;
+                for(int ix = 0; ix + 8 <= size; ix += 8)
+                {
+                    const uint8_t *r = payload + ix;
+                    int pageNumber = r[0] | (r[1] << 8);
+                    int itemNumber = r[2] | (r[3] << 8);
+                    int value = (int)((uint32_t)r[4] | ((uint32_t)r[5] << 8) | ((uint32_t)r[6] << 16) | ((uint32_t)r[7] << 24));
+                    this->p->requestHandlerPages->controlValue(pageNumber, itemNumber, value);
+                }
+                break;
+
+            case 0x8: // close: answer in kind
+            {
+                const uint8_t closeFrame[2] = {0x88, 0x00};
+                slot.client.write(closeFrame, sizeof(closeFrame));
+                slot.close();
+                return;
+            }
+
+            case 0x9: // ping: pong, same payload
+            {
+                uint8_t pongHeader[2] = {0x8a, (uint8_t)size};
+                if(size <= 125)
+                {
+                    slot.client.write(pongHeader, sizeof(pongHeader));
+                    slot.client.write(payload, size);
+                }
+                break;
+            }
+
+            default: // text, pong: nothing for us
+                break;
+        }
+        in.dropRaw(at + 4 + size);
+    }
+}
+
+/// Send an open event stream whatever values changed since last time.
+void OmWebServer::serviceEventStream(OmWebServerClientSlot &slot)
+{
+    if(slot.webSocket)
+    {
+        this->serviceWebSocketInput(slot);
+        if(!slot.isOpen())
+            return;
+    }
+
+    uint32_t serial = this->p->requestHandlerPages->getValueSerial();
+    if(serial != slot.eventSerial)
+    {
+        this->p->beginStream(&slot.client, false, false);
+        if(slot.webSocket)
+        {
+            // 8-byte records; a stream block holds a whole number of them, so none is split across messages.
+            this->p->streamFraming = OWS_FRAMING_WEBSOCKET;
+            this->p->requestHandlerPages->renderValueRecords(this, slot.eventSerial);
+        }
+        else
+        {
+            this->p->streamFraming = OWS_FRAMING_CLOSE; // no http header this time, just events
+            this->p->requestHandlerPages->renderValueEvents(this, slot.eventSerial);
+        }
+        this->p->flushStream(false);
+        this->p->endStream();
+        slot.eventSerial = serial;
+        slot.startMillis = this->p->uptimeMillis;
+    }
+    else if(this->p->uptimeMillis - slot.startMillis > OMWS_EVENT_HEARTBEAT)
+    {
+        if(slot.webSocket)
+            slot.client.write((const uint8_t *)"\x89\x00", 2); // ping
+        else
+            slot.client.write((const uint8_t *)":\n\n", 3);
+        slot.startMillis = this->p->uptimeMillis;
+    }
 }
 
 const char *OmWebServer::getSsid()
@@ -863,6 +1707,17 @@ void OmWebServer::rebootIn(int millis)
     this->p->rebootMillis = this->p->uptimeMillis + millis;
 }
 
+void OmWebServer::setKeepAlive(int idleMillis, int maxRequests)
+{
+    this->p->keepAliveIdleMillis = idleMillis > 0 ? idleMillis : 0;
+    this->p->keepAliveMaxRequests = maxRequests;
+}
+
+void OmWebServer::setWebSocket(bool enabled)
+{
+    this->p->webSocketEnabled = enabled;
+}
+
 bool OmWebServer::isAccessPoint()
 {
     return this->p->accessPoint;
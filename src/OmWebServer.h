@@ -28,8 +28,6 @@
  * The IP address will also be "blinked" on the BUILTIN_LED.
  */
 
-#ifndef NOT_ARDUINO
-
 #ifndef __OmWebServer__
 #define __OmWebServer__
 
@@ -40,6 +38,9 @@
 #ifdef ARDUINO_ARCH_ESP32
 #include <WiFi.h>
 #endif
+#if NOT_ARDUINO
+#include "OmHostWiFi.h"
+#endif
 
 #include "OmWebPages.h"
 #include "OmNtp.h"
@@ -55,6 +56,8 @@ typedef void (* OmConnectionStatus)(const char *ssid, bool trying, bool failure,
 #endif
 
 class OmWebServerPrivates;
+class OmHttpRequestParser;
+class OmWebServerClientSlot;
 
 /*! @brief Manages wifi connection, and forwarding http requests to a handler, typically OmWebPages */
 
@@ -118,6 +121,20 @@ public:
     /*! @brief defaults to 80 */
     void setPort(int port);
     
+    /*! @brief Let browsers reuse a connection for more requests, like the stream of
+     /_control requests from dragging a slider. A connection is closed after idleMillis
+     with no new request, or after maxRequests. 0 (the default) closes after every response.
+     Small responses are sent with a Content-Length, bigger ones with chunked transfer encoding.
+     */
+    void setKeepAlive(int idleMillis, int maxRequests = 100);
+
+    /*! @brief Offer a websocket at "/_ws" to OmWebPages' builtin script. Control values
+     then go both ways on it as small binary frames, instead of an http request per
+     change, so dragging a slider can update much faster. Off by default; browsers
+     fall back to "/_control" requests and the "/_events" stream.
+     */
+    void setWebSocket(bool enabled);
+
     /*! @brief changes or disables the blinking status LED. Use -1 to disable. */
     void setStatusLedPin(int statusLedPin);
     
@@ -145,6 +162,7 @@ public:
     long long uptimeMillis();
 
     bool put(uint8_t) override;
+    bool putN(const uint8_t *data, size_t size) override;
     bool done() override;
     bool put(const char *s); // helpers to send longer amounts & strings
     bool put(uint8_t *d, int size); // helpers to send longer amounts & strings
@@ -158,7 +176,11 @@ public:
     static OmWebServer *s; // most recent created. Really, the only one.
 private:
     /* public for callback purposes, not user-useful */
-    void handleRequest(String request, WiFiClient &client);
+    bool handleRequest(OmHttpRequestParser &request, WiFiClient &client, bool keepAlive);
+    void beginEventStream(OmWebServerClientSlot &slot);
+    void serviceEventStream(OmWebServerClientSlot &slot);
+    bool beginWebSocket(OmWebServerClientSlot &slot);
+    void serviceWebSocketInput(OmWebServerClientSlot &slot);
 
     /* state machine business. */
     void owsBegin();
@@ -169,5 +191,3 @@ private:
 };
 
 #endif // __OmWebServer__
-
-#endif
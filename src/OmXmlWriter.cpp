@@ -9,51 +9,32 @@
 #include "OmXmlWriter.h"
 #include "OmUtil.h"
 #include "OmPrintfStream.h"
+#include <stddef.h>
 #include <stdlib.h>
 
-static const int HAS_ANYTHING = 1;
-static const int HAS_SUBELEMENT = 2;
-static const int HAS_TEXT = 4;
+// each level's flags; if either is set, it has something, and its start tag is closed.
+static const int HAS_SUBELEMENT = 1;
+static const int HAS_TEXT = 2;
 
-class XmlContentEscaper : public OmIByteStream
+bool OmIByteStream::putS(const char *s)
 {
-public:
-    OmIByteStream *consumer = NULL;
-    XmlContentEscaper()
-    {
-        return;
-    }
-
-    bool putX(const char *s)
-    {
-        bool ok = true;
-        while(char ch = *s++)
-        {
-            ok &= this->consumer->put(ch);
-        }
-        return ok;
-    }
+    if(!omIsFlash(s))
+        return this->putN((const uint8_t *)s, strlen(s));
 
-    virtual bool put(uint8_t ch)
+    // flash can only be read a word at a time, so it comes over in pieces.
+    bool result = true;
+    uint8_t piece[32];
+    size_t len = strlen_P(s);
+    for(size_t ix = 0; ix < len; ix += sizeof(piece))
     {
-        if(this->isDone || !this->consumer)
-            return false;
-
-        bool ok = true;
-        switch(ch)
-        {
-            case '"': ok = this->putX("&quot;"); break;
-            case '<': ok = this->putX("&lt;"); break;
-            case '&': ok = this->putX("&amp;"); break;
-            default:
-                ok = this->consumer->put(ch);
-                break;
-        }
-        return ok; // yup, did.
+        size_t k = len - ix;
+        if(k > sizeof(piece))
+            k = sizeof(piece);
+        memcpy_P(piece, s + ix, k);
+        result &= this->putN(piece, k);
     }
-};
-
-XmlContentEscaper xmlContentEscaper;
+    return result;
+}
 
 /// Instantiate an XML writer to write into the specified buffer
 OmXmlWriter::OmXmlWriter(OmIByteStream *consumer)
@@ -74,18 +55,31 @@ void OmXmlWriter::cr()
         puts("\n");
 }
 
+/// the flags of an open element, by depth; 0 is the document itself.
+int OmXmlWriter::getFlags(int level)
+{
+    return (this->elementFlags[level / 16] >> (2 * (level % 16))) & 3;
+}
+
+void OmXmlWriter::setFlags(int level, int flags)
+{
+    uint32_t &word = this->elementFlags[level / 16];
+    int shift = 2 * (level % 16);
+    word = (word & ~((uint32_t)3 << shift)) | ((uint32_t)flags << shift);
+}
+
 void OmXmlWriter::addingToElement(bool addContent)
 {
     // call this before inserting content or another element, in an elemnet.
-    if(depth > 0 && this->hasAnything[depth] == 0)
+    int flags = this->getFlags(this->depth);
+    if(this->depth > 0 && flags == 0)
     {
         puts(">");
         if(!addContent) // for embedded text content, we omit line feeds and indents around it. at least a little.
             this->cr();
     }
-    
-    this->hasAnything[depth] |= HAS_ANYTHING;
-    this->hasAnything[depth] |= addContent ? HAS_TEXT : HAS_SUBELEMENT;
+
+    this->setFlags(this->depth, flags | (addContent ? HAS_TEXT : HAS_SUBELEMENT));
 }
 
 
@@ -94,10 +88,19 @@ void OmXmlWriter::beginElement(const char *elementName)
     this->inElementContentWithEscapes = false;
     this->endAttribute(); // close any such open element.
 
+    if(this->depth >= kOmXmlMaxDepth || this->overflowDepth)
+    {
+        // No room to remember it, so it's left out, with its attributes and end.
+        // Its content goes in the element it's in.
+        this->errorCount++;
+        this->overflowDepth++;
+        return;
+    }
+
     this->addingToElement(false);
     this->depth++;
-    this->hasAnything[depth] = 0;
-    this->elementName[depth] = elementName;
+    this->setFlags(this->depth, 0);
+    this->elementName[this->depth - 1] = elementName;
     this->indent();
     putf("<%s",elementName);
 }
@@ -109,97 +112,93 @@ void OmXmlWriter::beginElement(const char *elementName, const char *attribute1,
 }
 
 
-static int putSome(char *writeHere, const char *s)
+#define OMXE_BIT(ch) ((uint64_t)1 << (ch))
+/// Which bytes each EOmXmlEscapes escapes, as bits. They're all below 64.
+static const uint64_t xmlEscapeMasks[] =
 {
-    int k = 0;
-    while(char c = *s++)
+    0, // OMXE_NONE
+    OMXE_BIT('"') | OMXE_BIT('<') | OMXE_BIT('&'), // OMXE_CONTENT
+    OMXE_BIT('"') | OMXE_BIT('<') | OMXE_BIT('&') | OMXE_BIT('\n'), // OMXE_ATTRIBUTE, keeping line breaks
+    OMXE_BIT('"') | OMXE_BIT('<') | OMXE_BIT('&') | OMXE_BIT('\n') | OMXE_BIT(' '), // OMXE_URL
+};
+
+/// The entity for a byte that its mask says to escape.
+static const char *xmlEscapeFor(uint8_t ch)
+{
+    switch(ch)
     {
-        *writeHere++ = c;
-        k++;
+        case '"': return "&quot;";
+        case '<': return "&lt;";
+        case '&': return "&amp;";
+        case '\n': return "&#10;";
+        case ' ': return "%20";
     }
-    return k;
+    return "";
 }
 
-// either for element or for attribute. attributes need &#10; and &#13; for line breaks.
-// return 0 for ok, 1 for errors.
-// TODO: this could be a class method, this->putWithEscapes(), in every instance, to avoid intermediate buffer. dvb2019.
-static int doEscapes(const char *sIn, int outSize, char *sOut,
-                     bool forElement = false,
-                     bool isUrl = false)
+/// A machine word, for checking several bytes in one go: 4 of them on the ESPs, 8 on most hosts.
+typedef size_t OmXmlWord __attribute__((__may_alias__));
+static const size_t kWordOnes = (size_t)-1 / 0xff; // 0x01 in every byte
+static const size_t kWordHighs = kWordOnes * 0x80;
+
+/// Nonzero if any byte of w is c. (The classic zero-byte test, on w with c xor'd out of every byte.)
+static inline size_t wordHasByte(size_t w, uint8_t c)
 {
-    int position = 0;
-    
-    if(forElement)
+    size_t x = w ^ (kWordOnes * c);
+    return (x - kWordOnes) & ~x & kWordHighs;
+}
+
+/// Whether any byte of w needs escaping, as content or an attribute.
+static inline bool wordNeedsEscape(size_t w, EOmXmlEscapes escapes)
+{
+    size_t hits = wordHasByte(w, '"') | wordHasByte(w, '<') | wordHasByte(w, '&');
+    if(escapes == OMXE_ATTRIBUTE)
+        hits |= wordHasByte(w, '\n');
+    return hits != 0;
+}
+
+/// Sends the clean run up to each byte that needs escaping in one go, then its entity.
+/// One pass, straight to the consumer, so there's no limit on how long.
+/// Runs are scanned a word at a time, where aligned; only a word with a hit in it
+/// gets looked at byte by byte. (The ESP8266 can't load a word that isn't aligned.)
+/// Urls are short, with spaces all through them, so they just go byte by byte.
+bool OmXmlWriter::putEscaped(const uint8_t *data, size_t size, EOmXmlEscapes escapes)
+{
+    bool ok = true;
+    const uint8_t *run = data;
+    const uint8_t *end = data + size;
+    uint64_t mask = xmlEscapeMasks[escapes];
+    bool byWords = escapes != OMXE_URL;
+    if(mask)
     {
-        // if there's any '<' or some others do cdata.
-        bool hasLt = false;
-        char c;
-        const char *sInW = sIn;
-        while((c = *sInW++) && !hasLt)
+        while(data < end)
         {
-            switch(c)
+            if(byWords && ((uintptr_t)data & (sizeof(size_t) - 1)) == 0)
             {
-                case '<':
-                case '"':
-                    hasLt = true;
+                while(end - data >= (ptrdiff_t)sizeof(size_t) && !wordNeedsEscape(*(const OmXmlWord *)data, escapes))
+                    data += sizeof(size_t);
+                if(data == end)
                     break;
             }
-        }
-        
-        if(hasLt)
-        {
-            sInW = sIn;
-            position = putSome(position + sOut, "<![CDATA[");
-            while(char c = *sIn++)
-            {
-                sOut[position++] = c;
-                if(position >= outSize - 3)
-                {
-                    sOut[position] = 0;
-                    return 1;
-                }
-            }
-            position += putSome(position + sOut, "]]>");
-            sOut[position++] = 0;
-            return 0;
+            uint8_t ch = *data++;
+            if(ch >= 64 || !((mask >> ch) & 1))
+                continue;
+            const char *escape = xmlEscapeFor(ch);
+            ok &= this->putRaw(run, data - 1 - run);
+            ok &= this->putRaw((const uint8_t *)escape, strlen(escape));
+            run = data;
         }
     }
-    
-    while(char c = *sIn++)
-    {
-        if(outSize - position < 10)
-        {
-            return 1;
-        }
-        
-        switch(c)
-        {
-            case '"':
-                position += putSome(position + sOut, "&quot;");
-                break;
-            case '<':
-                position += putSome(position + sOut, "&lt;");
-                break;
-            case '&':
-                position += putSome(position + sOut, "&amp;");
-                break;
-            case 10:
-                position += putSome(position + sOut, "&#10;");
-                break;
-            case ' ':
-                if(isUrl)
-                    position += putSome(position + sOut, "%20");
-                else
-                    sOut[position++] = c;
-                break;
-                
-            default:
-                sOut[position++] = c;
-                break;
-        }
-    }
-    sOut[position] = 0;
-    return 0;
+    ok &= this->putRaw(run, end - run);
+    return ok;
+}
+
+bool OmXmlWriter::putRaw(const uint8_t *data, size_t size)
+{
+    if(size == 0)
+        return true;
+    this->byteCount += size;
+    return this->consumer->putN(data, size);
 }
 
 #define TINY_XML_ADD_MAX 1000
@@ -209,7 +208,7 @@ void OmXmlWriter::addContent(const char *content)
     bool doEscapes = true;
     if(this->depth)
     {
-        const char *currentElement = this->elementName[this->depth];
+        const char *currentElement = this->elementName[this->depth - 1];
         if(omStringEqual("script", currentElement))
             doEscapes = false;
     }
@@ -222,6 +221,26 @@ void OmXmlWriter::addContentRaw(const char *content)
     this->puts(content); // no escapes. Just add text.
 }
 
+void OmXmlWriter::addContent(const __FlashStringHelper *content)
+{
+    this->addContent((const char *)content);
+}
+
+void OmXmlWriter::addContentRaw(const __FlashStringHelper *content)
+{
+    this->addContentRaw((const char *)content);
+}
+
+void OmXmlWriter::addAttribute(const char *attribute, const __FlashStringHelper *value)
+{
+    this->addAttribute(attribute, (const char *)value);
+}
+
+void OmXmlWriter::addElement(const char *elementName, const __FlashStringHelper *content)
+{
+    this->addElement(elementName, (const char *)content);
+}
+
 void OmXmlWriter::addContentF(const char *fmt,...)
 {
     va_list v;
@@ -229,14 +248,11 @@ void OmXmlWriter::addContentF(const char *fmt,...)
 
     this->addContent(""); // trigger any setup...
 
-    OmIByteStream *dest = this;
+    EOmXmlEscapes was = this->streamEscapes;
     if(this->inElementContentWithEscapes)
-    {
-        dest = &xmlContentEscaper;
-        xmlContentEscaper.consumer = this;
-    }
-    OmPrintfStream::putVF(dest, fmt, v);
-    return;
+        this->streamEscapes = OMXE_CONTENT;
+    OmPrintfStream::putVF(this, fmt, v); // through our putN(), escaped
+    this->streamEscapes = was;
 }
 
 
@@ -245,10 +261,9 @@ void OmXmlWriter::addAttribute(const char *attribute, const char *value)
     this->endAttribute(); // just in case
     if(attribute && value)
     {
-        char valueEscaped[TINY_XML_ADD_MAX];
-        this->errorCount += doEscapes(value, sizeof(valueEscaped), valueEscaped);
-        
-        this->putf(" %s=\"%s\"",attribute,valueEscaped);
+        this->beginAttribute(attribute);
+        this->putS(value); // through our putN(), escaped, and from flash if need be
+        this->endAttribute();
     }
 }
 
@@ -258,12 +273,10 @@ void OmXmlWriter::addAttributeF(const char *attribute, const char *fmt,...)
     char value[TINY_XML_ADD_MAX];
     va_list ap;
     va_start(ap,fmt);
-    vsnprintf(value,sizeof(value),fmt,ap);
-    
-    char valueEscaped[TINY_XML_ADD_MAX];
-    this->errorCount += doEscapes(value, sizeof(valueEscaped), valueEscaped);
+    if(vsnprintf(value,sizeof(value),fmt,ap) >= (int)sizeof(value))
+        this->errorCount++;
 
-    putf(" %s=\"%s\"",attribute,valueEscaped);
+    this->addAttribute(attribute, value);
 }
 
 void OmXmlWriter::addAttributeFBig(int reserve, const char *attribute, const char *fmt,...)
@@ -271,7 +284,6 @@ void OmXmlWriter::addAttributeFBig(int reserve, const char *attribute, const cha
     this->endAttribute(); // just in case
 
     char *value = NULL;
-    char *valueEscaped = NULL;
     value = (char *)calloc(1, reserve);
     int wrote;
     if(!value)
@@ -279,12 +291,6 @@ void OmXmlWriter::addAttributeFBig(int reserve, const char *attribute, const cha
         this->errorCount++;
         goto goHome;
     }
-    valueEscaped = (char *)calloc(1, reserve);
-    if(!valueEscaped)
-    {
-        this->errorCount++;
-        goto goHome;
-    }
 
     va_list ap;
     va_start(ap,fmt);
@@ -292,19 +298,11 @@ void OmXmlWriter::addAttributeFBig(int reserve, const char *attribute, const cha
     if(wrote < 0 || wrote >= reserve - 1)
         this->errorCount++;
 
-    this->errorCount += doEscapes(value, reserve, valueEscaped);
-
-    puts(" ");
-    puts(attribute);
-    puts("=\"");
-    puts(valueEscaped);
-    puts("\"");
+    this->addAttribute(attribute, value);
 
 goHome:
     if(value)
         free(value);
-    if(valueEscaped)
-        free(valueEscaped);
 }
 
 
@@ -313,17 +311,20 @@ void OmXmlWriter::addAttributeUrlF(const char *attribute, const char *fmt,...)
     char value[TINY_XML_ADD_MAX];
     va_list ap;
     va_start(ap,fmt);
-    vsnprintf(value,sizeof(value),fmt,ap);
-    
-    char valueEscaped[TINY_XML_ADD_MAX];
-    this->errorCount += doEscapes(value, sizeof(valueEscaped), valueEscaped, false, true);
-    
-    putf(" %s=\"%s\"",attribute,valueEscaped);
+    if(vsnprintf(value,sizeof(value),fmt,ap) >= (int)sizeof(value))
+        this->errorCount++;
+
+    this->beginAttribute(attribute);
+    this->streamEscapes = OMXE_URL;
+    this->putS(value);
+    this->endAttribute();
 }
 
 void OmXmlWriter::addAttribute(const char *attribute, long long int value)
 {
     this->endAttribute(); // just in case
+    if(this->overflowDepth)
+        return; // on an element that was left out
     putf(" %s=\"%lld\"",attribute,value);
 }
 
@@ -358,17 +359,29 @@ void OmXmlWriter::endElement()
 void OmXmlWriter::endElement(const char *elementName)
 {
     this->inElementContentWithEscapes = false;
+    this->endAttribute();
+    if(this->overflowDepth)
+    {
+        this->overflowDepth--; // one that was left out
+        return;
+    }
+    if(this->depth <= 0)
+    {
+        this->errorCount++; // more ends than begins
+        return;
+    }
     if(elementName)
     {
-        if(strcmp(elementName, this->elementName[this->depth]))
+        if(strcmp(elementName, this->elementName[this->depth - 1]))
             this->errorCount++;
     }
 
-    if(this->hasAnything[depth])
+    int flags = this->getFlags(this->depth);
+    if(flags)
     {
-        if(!(this->hasAnything[depth] & HAS_TEXT)) // no indent if an element has character content
+        if(!(flags & HAS_TEXT)) // no indent if an element has character content
             this->indent();
-        putf("</%s>",this->elementName[depth]);
+        putf("</%s>",this->elementName[this->depth - 1]);
     }
     else
         puts("/>");
@@ -378,7 +391,7 @@ void OmXmlWriter::endElement(const char *elementName)
 
 void OmXmlWriter::endElements()
 {
-    while(this->depth)
+    while(this->depth || this->overflowDepth)
         this->endElement();
 }
 
@@ -404,31 +417,16 @@ void OmXmlWriter::putf(const char *fmt,...)
 
 bool OmXmlWriter::puts(const char *stuff, bool contentEscapes)
 {
-    long len = strlen(stuff);
-    bool result = true; // success
-
-    // TODO here is where we could consider checking
-    // running flags like addingToElement and addingToAttribute
-    // to see how best to escape them.
-    // TODO: right now CDATA never happens, we never do escapes
-    // on content blocks.
-    // sometimes this is good, to let you manually add
-    // in XML/HTML directives but you have to be rigorous.
-    // Maybe we need addContent and addContentRaw.
-    if(this->consumer)
-    {
-        OmIByteStream *dest = this->consumer;
-        if(contentEscapes)
-        {
-            dest = &xmlContentEscaper;
-            xmlContentEscaper.consumer = this->consumer;
-        }
-        for(int ix = 0; ix < len; ix++)
-        {
-            this->byteCount++;
-            result &= dest->put(stuff[ix]);
-        }
-    }
+    if(!this->consumer)
+        return true;
+    if(!omIsFlash(stuff))
+        return this->putEscaped((const uint8_t *)stuff, strlen(stuff), contentEscapes ? OMXE_CONTENT : OMXE_NONE);
+
+    // by way of our putN(), which streams flash strings in pieces.
+    EOmXmlEscapes was = this->streamEscapes;
+    this->streamEscapes = contentEscapes ? OMXE_CONTENT : OMXE_NONE;
+    bool result = this->putS(stuff);
+    this->streamEscapes = was;
     return result;
 }
 
@@ -437,6 +435,22 @@ void OmXmlWriter::setIndenting(int onOff)
     this->indenting = onOff;
 }
 
+void OmXmlWriter::setMinified(bool onOff)
+{
+    this->minified = onOff;
+}
+
+void OmXmlWriter::addNewline()
+{
+    if(!this->minified)
+    {
+        this->addContent("\n");
+        return;
+    }
+    this->addContent(""); // still closes the start tag, as the line break would have
+    this->minifiedBytes++;
+}
+
 int OmXmlWriter::getErrorCount()
 {
     return this->errorCount;
@@ -449,10 +463,15 @@ unsigned int OmXmlWriter::getByteCount()
 
 bool OmXmlWriter::put(uint8_t ch)
 {
-    // direct output, with byte counting.
-    this->byteCount++;
-    bool result = this->consumer->put(ch);
-    return result;
+    return this->putN(&ch, 1);
+}
+
+bool OmXmlWriter::putN(const uint8_t *data, size_t size)
+{
+    // direct output, with byte counting. Streaming into an attribute, or for addContentF(), it's escaped.
+    if(this->attributeName && this->overflowDepth)
+        return true; // an attribute of an element that was left out
+    return this->putEscaped(data, size, this->streamEscapes);
 }
 
 bool OmXmlWriter::done()
@@ -464,14 +483,19 @@ void OmXmlWriter::beginAttribute(const char *attributeName)
 {
     this->endAttribute(); // really, almost every method should call this. Just in case it's sitting open.
     this->attributeName = attributeName;
+    if(this->overflowDepth)
+        return; // on an element that was left out; putN() drops its value
     this->putf(" %s=\"", attributeName);
+    this->streamEscapes = OMXE_ATTRIBUTE;
 }
 void OmXmlWriter::endAttribute()
 {
     if(this->attributeName)
     {
         // an attribute is open, so close it.
-        this->put('"');
         this->attributeName = 0;
+        this->streamEscapes = OMXE_NONE;
+        if(!this->overflowDepth)
+            this->put('"');
     }
 }
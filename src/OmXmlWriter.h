@@ -48,6 +48,8 @@
 #include <string.h>
 #include <stdint.h>
 
+class __FlashStringHelper; // F("..."), as Arduino's String has it
+
 /*! Interface for streaming byte output. Can be chained together, and used as a destination by OmXmlWriter */
 class OmIByteStream
 {
@@ -69,20 +71,39 @@ public:
         return true;
     }
 
-    /*! @brief convenience routine, same as put byte-by-byte. */
-    virtual bool putS(const char *s)
+    /*!
+     @brief emit a run of bytes. Same as put byte-by-byte, but implementations
+     override it to pass the whole run along at once.
+     */
+    virtual bool putN(const uint8_t *data, size_t size)
     {
         bool result = true;
-        while(uint8_t ch = (uint8_t)(*s++))
-        {
-            result &= this->put(ch);
-        }
+        while(size-- > 0)
+            result &= this->put(*data++);
         return result;
     }
+
+    /*! @brief convenience routine, same as put byte-by-byte. The string can be in flash (see omIsFlash()). */
+    virtual bool putS(const char *s);
     
     bool isDone = false;
 };
 
+/*! Elements an OmXmlWriter can have open at once, 4 bytes each on the ESPs. Past that,
+ elements are left out, and counted in getErrorCount(). */
+#ifndef OM_XML_MAX_DEPTH
+#define OM_XML_MAX_DEPTH 20
+#endif
+
+/*! @brief What OmXmlWriter escapes on the way out */
+typedef enum
+{
+    OMXE_NONE = 0,
+    OMXE_CONTENT, // " < and & as entities
+    OMXE_ATTRIBUTE, // those, and line breaks as &#10;
+    OMXE_URL, // those, and spaces as %20
+} EOmXmlEscapes;
+
 /*!
  @class OmXmlWriter
  Writes formatted XML to an OmIByteStream, streaming as it goes (mostly)
@@ -90,13 +111,15 @@ public:
 class OmXmlWriter : public OmIByteStream
 {
 public:
-    static const int kOmXmlMaxDepth = 20;
+    static const int kOmXmlMaxDepth = OM_XML_MAX_DEPTH;
     OmIByteStream *consumer = 0;
-    int depth = 0;
-    int hasAnything[kOmXmlMaxDepth];
-    const char *elementName[kOmXmlMaxDepth];
-    int position = 0; // index into output
+    int depth = 0; // elements open
+    const char *elementName[kOmXmlMaxDepth]; // of the open elements, outermost first
+    uint32_t elementFlags[(2 * (kOmXmlMaxDepth + 1) + 31) / 32] = {0}; // two bits for the document, and for each open element
+    int overflowDepth = 0; // elements begun past kOmXmlMaxDepth, left out along with their ends
     bool indenting = false;
+    bool minified = false;
+    unsigned int minifiedBytes = 0; // left out by minifying; getByteCount() plus these is the size it would have been
     int errorCount = 0;
     unsigned int byteCount = 0;
 
@@ -119,6 +142,14 @@ public:
      */
     void addContentRaw(const char *content);
 
+    /*! @brief The same, for F("...") strings, streamed from flash without a copy in RAM.
+     Plain const char * can be in flash too, like PSTR("..."); it's checked by address.
+     */
+    void addContent(const __FlashStringHelper *content);
+    void addContentRaw(const __FlashStringHelper *content);
+    void addAttribute(const char *attribute, const __FlashStringHelper *value);
+    void addElement(const char *elementName, const __FlashStringHelper *content);
+
     /*! @brief Adds text to an element, using printf semantics */
     void addContentF(const char *fmt,...);
     
@@ -162,6 +193,12 @@ public:
     
     /*! @brief Enables primitive formatting. Uses more bytes of buffer. */
     void setIndenting(int onOff);
+
+    /*! @brief Leaves out the addNewline()s, for smaller pages. */
+    void setMinified(bool onOff);
+
+    /*! @brief A line break between elements, only there for people reading the source. None when minified. */
+    void addNewline();
     
     /*! @brief Returns nonzero of any errors occurred, usually buffer overruns leading to missing portions. */
     int getErrorCount();
@@ -173,6 +210,7 @@ public:
     OmXmlWriter needs to know what context it's in, to manage escapes correctly.
     also relies upon some new concepts like beginAttribute, &lt;stream a big attribute value>, endAttribute. */
     bool put(uint8_t ch) override;
+    bool putN(const uint8_t *data, size_t size) override;
     bool done() override;
 
     void beginAttribute(const char *attributeName);
@@ -185,7 +223,12 @@ private:
     void indent();
     void cr();
     void addingToElement(bool addContent);
+    int getFlags(int level);
+    void setFlags(int level, int flags);
     bool inElementContentWithEscapes = false; // triggered by addContent, halted by beginElement and endElement. But not inside <script> for example.
+    EOmXmlEscapes streamEscapes = OMXE_NONE; // what put() and putN() escape, like inside an attribute
+    bool putEscaped(const uint8_t *data, size_t size, EOmXmlEscapes escapes);
+    bool putRaw(const uint8_t *data, size_t size);
 };
 
 #endif /* defined(__OmXmlWriter__) */
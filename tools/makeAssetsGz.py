@@ -0,0 +1,178 @@
+#!/usr/bin/env python3
+#
+# makeAssetsGz.py
+#
+# Regenerates src/OmWebPagesAssets.h, the gzipped and minified copies of
+# OmWebPages' builtin style and script. Run it after changing
+# renderStyleContent() or renderScriptContent(), against any running
+# OmWebServer:
+#
+#     tools/makeAssetsGz.py 192.168.1.23
+#
+# Minifying takes out the comments and most of the whitespace, and nothing
+# else; names are left alone. OmWebPages sends the minified copies when
+# it's built with OMWP_MINIFY, as it is by default.
+#
+# Each blob records the ETag of the text it was made from. If the text
+# changes and this isn't rerun, OmWebPages notices the mismatch and just
+# serves the text as written, so a stale header is never wrong, only slower.
+#
+# tools/makeAssetsGz.py --check decompresses the blobs in the header and
+# compares them to what the server sends. Without a server, omWebBench -a
+# checks that the ETags and sizes in the header are those of the current
+# text, which is enough to catch forgetting to rerun this.
+#
+
+import gzip
+import os
+import re
+import sys
+import urllib.request
+
+ASSETS = [("style", "_om.css"), ("script", "_om.js")]
+HEADER = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src", "OmWebPagesAssets.h")
+
+
+def fetch(host, url):
+    """The text as written, not minified, and its ETag."""
+    r = urllib.request.urlopen(urllib.request.Request("http://%s/%s?min=0" % (host, url),
+                                                      headers={"Accept-Encoding": "identity"}))
+    etag = r.headers["ETag"].strip('"')
+    return r.read(), int(etag, 16)
+
+
+IDENTIFIER = re.compile(r"[A-Za-z0-9_$]")
+
+
+def minifyJs(text):
+    """Comments out, and each run of whitespace down to one space or line break, or
+    nothing at all where a punctuation mark is on either side. A line break stays
+    unless the line plainly goes on, so semicolons left off still aren't needed."""
+    out = []
+    ix = 0
+    n = len(text)
+
+    def whitespace(hadBreak):
+        nonlocal ix
+        while ix < n and text[ix].isspace():
+            hadBreak = hadBreak or text[ix] == "\n"
+            ix += 1
+        if not out or ix >= n:
+            return
+        before, after = out[-1][-1], text[ix]
+        if before == "\n":
+            return  # a line of comment, gone
+        if hadBreak and before not in "{;,(=:[&|?+-*/<>!" and after not in "{})],;.?:&|=":
+            out.append("\n")
+        elif IDENTIFIER.match(before) and IDENTIFIER.match(after):
+            out.append(" ")
+
+    while ix < n:
+        ch = text[ix]
+        if ch in "'\"":
+            end = ix + 1
+            while text[end] != ch:
+                end += 2 if text[end] == "\\" else 1
+            out.append(text[ix:end + 1])
+            ix = end + 1
+        elif text.startswith("//", ix):
+            ix = text.find("\n", ix)
+            ix = n if ix < 0 else ix
+            whitespace(False)
+        elif text.startswith("/*", ix):
+            ix = text.index("*/", ix) + 2
+            whitespace(False)
+        elif ch.isspace():
+            whitespace(False)
+        else:
+            out.append(ch)
+            ix += 1
+    return "".join(out)
+
+
+def minifyCss(text):
+    """Comments out, and whitespace down to one space, or nothing around punctuation.
+    A space before a colon stays, "a :hover" isn't "a:hover", and so do spaces
+    around + and -, which calc() needs."""
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    text = re.sub(r"\s+", " ", text).strip()
+    text = re.sub(r"\s*([{};,>])\s*", r"\1", text)
+    text = re.sub(r":\s+", ":", text)
+    return text.replace(";}", "}")
+
+
+MINIFY = {"style": minifyCss, "script": minifyJs}
+
+
+def cArray(name, data):
+    lines = []
+    for ix in range(0, len(data), 16):
+        lines.append("    " + ",".join("0x%02x" % b for b in data[ix:ix + 16]) + ",")
+    return "static const uint8_t %s[%d] PROGMEM =\n{\n%s\n};\n" % (name, len(data), "\n".join(lines))
+
+
+def cString(name, text):
+    assert ")MIN\"" not in text
+    return "static const char %s[] PROGMEM = R\"MIN(%s)MIN\";\n" % (name, text)
+
+
+def write(host):
+    out = []
+    out.append("/*\n"
+               " * OmWebPagesAssets.h\n"
+               " *\n"
+               " * Gzipped and minified builtin style and script for OmWebPages, served\n"
+               " * in place of the text as written. GENERATED by tools/makeAssetsGz.py,\n"
+               " * do not edit.\n"
+               " */\n\n"
+               "#ifndef __OmWebPagesAssets__\n"
+               "#define __OmWebPagesAssets__\n\n"
+               "#include <stdint.h>\n\n"
+               "#ifdef NOT_ARDUINO\n"
+               "#define PROGMEM\n"
+               "#define memcpy_P memcpy\n"
+               "#endif\n")
+    for name, url in ASSETS:
+        text, etag = fetch(host, url)
+        gz = gzip.compress(text, 9, mtime=0)
+        mini = MINIFY[name](text.decode()).encode()
+        miniGz = gzip.compress(mini, 9, mtime=0)
+        out.append("\n// %s: %d bytes, gzipped to %d; minified %d, gzipped to %d\n"
+                   % (url, len(text), len(gz), len(mini), len(miniGz)))
+        out.append("#define OM_ASSET_%s_ETAG 0x%08x\n" % (name.upper(), etag))
+        out.append("#define OM_ASSET_%s_SIZE %d\n" % (name.upper(), len(text)))
+        out.append(cArray("omAsset%sGz" % name.capitalize(), gz))
+        out.append(cString("omAsset%sMin" % name.capitalize(), mini.decode()))
+        out.append(cArray("omAsset%sMinGz" % name.capitalize(), miniGz))
+    out.append("\n#endif // __OmWebPagesAssets__\n")
+    with open(HEADER, "w") as f:
+        f.write("".join(out))
+
+
+def check(host):
+    src = open(HEADER).read()
+    ok = True
+    def blob(name):
+        m = re.search(r"%s\[\d+\] PROGMEM =\s*\{([^}]*)\}" % name, src)
+        return gzip.decompress(bytes(int(x, 16) for x in re.findall(r"0x([0-9a-f]{2})", m.group(1))))
+
+    for name, url in ASSETS:
+        text, etag = fetch(host, url)
+        mini = MINIFY[name](text.decode()).encode()
+        m = re.search(r"omAsset%sMin\[\] PROGMEM = R\"MIN\((.*?)\)MIN\"" % name.capitalize(), src, re.S)
+        same = (blob("omAsset%sGz" % name.capitalize()) == text
+                and blob("omAsset%sMinGz" % name.capitalize()) == mini
+                and m.group(1).encode() == mini)
+        print("%s: %s" % (url, "ok" if same else "DIFFERENT, rerun makeAssetsGz.py"))
+        ok = ok and same
+    return ok
+
+
+if __name__ == "__main__":
+    args = sys.argv[1:]
+    if not args:
+        print("usage: makeAssetsGz.py [--check] <host[:port]>")
+        sys.exit(1)
+    if args[0] == "--check":
+        sys.exit(0 if check(args[1]) else 1)
+    write(args[0])
@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+#
+# omStatusBin.py
+#
+# Fetches and decodes OmWebPages' "_status.bin", the compact binary status
+# for polling lots of devices. The layout is described in OmWebPages.h,
+# at renderStatusBin() and EOmStatusBinTag.
+#
+#     tools/omStatusBin.py 192.168.1.23          # everything
+#     tools/omStatusBin.py 192.168.1.23 417      # items and eeprom ints changed after 417
+#
+# tools/omStatusBin.py --check 192.168.1.23 fetches "_status.bin" and
+# "_status.json" and checks that they agree, as a round trip test of the
+# encoder and this decoder.
+#
+
+import json
+import struct
+import sys
+import urllib.request
+
+SCALARS = {
+    1: "uptimeMillis",
+    2: "requests",
+    3: "requestsParam",
+    4: "requestsCached",
+    5: "maxHtml",
+    6: "freeHeap",
+    7: "changes",
+    8: "since",
+    9: "layout",
+    10: "leftOut",
+}
+SECTIONS = {
+    0x81: ("items", "<HHi", ("page", "item", "value")),
+    0x82: ("eepromInts", "<Hi", ("ix", "value")),
+}
+
+
+def decode(data):
+    """The record as a dict of scalars by name, and lists of dicts for the sections."""
+    magic, version, scalarCount, length = struct.unpack_from("<4sBBH", data, 0)
+    if magic != b"OmSB":
+        raise ValueError("not a _status.bin record")
+    if length != len(data):
+        raise ValueError("length says %d, got %d bytes" % (length, len(data)))
+    result = {"version": version}
+    at = 8
+    descriptor = []
+    for ix in range(scalarCount):
+        descriptor.append(struct.unpack_from("<BB", data, at))
+        at += 2
+    for tag, size in descriptor:
+        value = int.from_bytes(data[at:at + size], "little")
+        result[SCALARS.get(tag, "tag%d" % tag)] = value
+        at += size
+    while at < length:
+        tag, recordSize, count = struct.unpack_from("<BBH", data, at)
+        at += 4
+        name, fmt, fields = SECTIONS.get(tag, ("tag%d" % tag, None, None))
+        records = []
+        for ix in range(count):
+            record = data[at:at + recordSize]
+            if fmt:
+                records.append(dict(zip(fields, struct.unpack_from(fmt, record, 0))))
+            else:
+                records.append(record.hex())
+            at += recordSize
+        result[name] = records
+    return result
+
+
+def fetch(host, url):
+    return urllib.request.urlopen("http://%s/%s" % (host, url)).read()
+
+
+def check(host):
+    b = decode(fetch(host, "_status.bin"))
+    j = json.loads(fetch(host, "_status.json"))
+    ok = True
+
+    def same(what, x, y):
+        nonlocal ok
+        if x != y:
+            print("%s: bin %s, json %s" % (what, x, y))
+            ok = False
+
+    jItems = {(int(i["pageId"][1:]), int(i["id"][1:])): i["value"] for i in j.get("items", [])}
+    bItems = {(i["page"], i["item"]): i["value"] for i in b["items"]}
+    same("items", bItems, jItems)
+    jInts = {f["ix"]: f["value"] for f in j.get("eeprom", {}).get("fields", []) if f["type"] == 1 and f["length"] <= 4}
+    bInts = {f["ix"]: f["value"] for f in b.get("eepromInts", [])}
+    same("eeprom ints", bInts, jInts)
+    same("changes", b["changes"], j["status"]["changes"])
+    print("%s: %d bytes bin, %d items, %d eeprom ints: %s"
+          % (host, len(fetch(host, "_status.bin")), len(bItems), len(bInts), "ok" if ok else "DIFFERENT"))
+    return ok
+
+
+if __name__ == "__main__":
+    args = sys.argv[1:]
+    if not args:
+        print("usage: omStatusBin.py [--check] <host[:port]> [since]")
+        sys.exit(1)
+    if args[0] == "--check":
+        sys.exit(0 if check(args[1]) else 1)
+    url = "_status.bin" + ("?since=%s" % args[1] if len(args) > 1 else "")
+    print(json.dumps(decode(fetch(args[0], url)), indent=1))
@@ -0,0 +1,26 @@
+/*
+ * EepromTesting.h
+ *
+ * A do-nothing EEPROM for host builds of OmEeprom and OmWebPages, so the
+ * bench links. Reads come back zero, writes go nowhere. A host build
+ * without omWebBench.cpp defines EEPROM itself.
+ */
+
+#ifndef __EepromTesting__
+#define __EepromTesting__
+
+#include <stdint.h>
+
+class EepromTestingClass
+{
+public:
+    void begin(int size) { (void)size; }
+    uint8_t read(int address) { (void)address; return 0; }
+    void write(int address, uint8_t value) { (void)address; (void)value; }
+    bool commit() { return true; }
+    void end() {}
+};
+
+extern EepromTestingClass EEPROM; // defined once, in omWebBench.cpp
+
+#endif // __EepromTesting__
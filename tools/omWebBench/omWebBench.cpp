@@ -0,0 +1,818 @@
+/*
+ * omWebBench.cpp
+ *
+ * A load generator for OmWebServer + OmWebPages, run on the desktop with
+ * the loopback backend in OmHostWiFi. One thread ticks the server the way
+ * loop() would; N client threads hammer it with HTTP GETs and the results
+ * come out as requests/s, p50/p99 latency, and bytes/s for each kind of
+ * request: the page render, /_control, and /_status.
+ *
+ * The numbers measure the library's own work (rendering, parsing, framing)
+ * without the radio, so they're for comparing one version of the code with
+ * the next, not for predicting what an ESP will do. A kept-alive connection
+ * the server closes before answering is retried once on a new one, as a
+ * browser would, and counted as retried; a request that still fails makes
+ * the run exit nonzero, so its numbers aren't taken for a success.
+ *
+ * BUILD (from the repository root)
+ *
+ *   g++ -std=c++14 -O2 -DNOT_ARDUINO=1 -Isrc -Itools/omWebBench \
+ *       tools/omWebBench/omWebBench.cpp src/OmHostWiFi.cpp src/OmWebServer.cpp \
+ *       src/OmWebPages.cpp src/OmXmlWriter.cpp src/OmJsonWriter.cpp src/OmPrintfStream.cpp \
+ *       src/OmUtil.cpp src/OmEeprom.cpp src/OmLog.cpp src/OmBlinker.cpp -lpthread -o omWebBench
+ *
+ * RUN
+ *
+ *   ./omWebBench [-c clients] [-n requestsPerClient] [-p port] [-k] [-0] [-d] [-x] [-w] [-t] [-b] [-a]
+ *
+ *   -k uses keep-alive connections, otherwise each request opens a new one.
+ *   -0 asks in HTTP/1.0, as "ab -k" does. It can't read chunks, so with -k a
+ *      response too big to frame with its own length has to come back with
+ *      "Connection: close", and be closed; anything else counts as failed.
+ *   -d skips the sockets and times OmWebPages' request dispatch in-process,
+ *      on a big site (32 pages of 24 items, 16 url handlers), in ns/request.
+ *   -x times OmXmlWriter's escaping in-process, on names, labels and html
+ *      like a page's, and on 4k blocks of log text, clean (nothing to escape)
+ *      and dirty (something every line), in MB/s of output.
+ *   -t checks, rather than times, the page cache: every bench page, and one of
+ *      every builtin control, rendered from a compiled template and rendered
+ *      directly, over a sweep of values, must come out byte for byte the same,
+ *      with a right Content-Length. Exits nonzero if not, so it can gate a build.
+ *   -b checks "_status.bin" the same way: decoded as tools/omStatusBin.py does,
+ *      its lengths and counts must add up and its values match the site's, on
+ *      a small site and on one too big for the 16 bit length, which must leave
+ *      records out and say how many.
+ *   -w times the same pages, and a 4k block of text, into a stream that takes
+ *      putN() whole and into one that only has put(), so the last hop goes a
+ *      byte at a time, as a stream without putN() would take it; the output
+ *      must be the same. In MB/s of output.
+ *   -a checks that src/OmWebPagesAssets.h isn't stale: the ETag and size it
+ *      records for _om.css and _om.js must be those of the text the code
+ *      renders now. A stale header isn't wrong, just big, so nothing else
+ *      would notice. Exits nonzero if it is.
+ */
+
+#include "OmWebServer.h"
+#include "OmWebPages.h"
+#include "OmEeprom.h"
+#include "OmWebPagesAssets.h"
+#include "EepromTesting.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+EepromTestingClass EEPROM; // the one EepromTesting.h declares, for OmEeprom
+
+static std::atomic<bool> serverRunning(true);
+
+static void benchProc(const char *page, const char *item, int value, int ref1, void *ref2)
+{
+    (void)page; (void)item; (void)value; (void)ref1; (void)ref2;
+}
+
+/// a page about the size of a real one: a dozen each of sliders, buttons and selects.
+static void buildPages(OmWebPages &p)
+{
+    p.beginPage("Bench");
+    for(int ix = 0; ix < 12; ix++)
+    {
+        p.addSlider(0, 100, "Level <x>", benchProc, 50, ix);
+        p.addButton("On & Off", benchProc, ix);
+        p.addSelect("Mode", benchProc, 1, ix);
+        p.addSelectOption("One & Two", 1);
+        p.addSelectOption("Three", 3);
+    }
+}
+
+class BenchNullStream : public OmIByteStream
+{
+public:
+    size_t count = 0;
+    bool put(uint8_t ch) override { (void)ch; this->count++; return true; }
+    bool putN(const uint8_t *data, size_t size) override { (void)data; this->count += size; return true; }
+};
+
+static void benchUrlProc(OmXmlWriter &w, OmWebRequest &request, int ref1, void *ref2)
+{
+    (void)w; (void)request; (void)ref1; (void)ref2;
+}
+
+/// finding the page, item, or handler is the part that grows with the site; time just that.
+static void runDispatch(int count)
+{
+    static std::vector<std::string> names;
+    names.reserve(32 + 24 + 16); // the pages keep pointers to these
+    OmWebPages p;
+    for(int ix = 0; ix < 16; ix++)
+    {
+        names.push_back("handler" + std::to_string(ix));
+        p.addUrlHandler(names.back().c_str(), benchUrlProc);
+    }
+    for(int ix = 0; ix < 24; ix++)
+        names.push_back("Button " + std::to_string(ix));
+    for(int pageIx = 0; pageIx < 32; pageIx++)
+    {
+        names.push_back("Page" + std::to_string(pageIx));
+        p.beginPage(names.back().c_str());
+        for(int ix = 0; ix < 24; ix++)
+            p.addButton(names[16 + ix].c_str(), benchProc);
+    }
+
+    OmRequestInfo ri;
+    BenchNullStream s;
+    const char *urls[] =
+    {
+        "/_control?page=p1&item=i0&value=1", // first item of the first page, by id
+        "/_control?page=p32&item=i23&value=1", // last item of the last page
+        "/handler15", // last url handler, behind all the pages
+    };
+    printf("omWebBench dispatch: 32 pages, %d requests each\n", count);
+    for(const char *url : urls)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        for(int ix = 0; ix < count; ix++)
+            p.handleRequest(&s, url, &ri);
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / count;
+        printf("%-40s %8.0f ns/request\n", url, ns);
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    for(int ix = 0; ix < count; ix++)
+        p.setValue("Page31", "Button 23", ix & 1);
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / count;
+    printf("%-40s %8.0f ns/call\n", "setValue(\"Page31\", \"Button 23\")", ns);
+}
+
+/// the text a page is made of: short names, some with a character to escape, and a longer run of static html.
+static const char *benchTexts[] =
+{
+    "Living room lamp",
+    "Level <x>",
+    "On & Off",
+    "Temperature: 21.5 C, humidity 40%",
+    "Schedule \"weekday\" mornings",
+    "This controller runs the garden lights and the pump. Set the evening schedule on the next page, "
+        "or turn things on and off right here; the changes show on every open browser within a second or so.\n",
+};
+
+/// escaping, on its own: the same texts as attribute values, element content, and urls; then big blocks of content.
+static void runEscapes(int count)
+{
+    std::string clean, dirty;
+    while(clean.size() < 4096)
+    {
+        clean += "20:15:03.250 wifi: connected to garden, rssi -61, ip 192.168.1.23, 3 clients\n";
+        dirty += "20:15:03.250 <wifi> connected to \"garden\" & rssi -61, ip 192.168.1.23\n";
+    }
+
+    const int kinds = 5;
+    const char *kindNames[kinds] = {"addAttribute", "addContent", "addAttributeUrlF", "addContent 4k clean", "addContent 4k dirty"};
+    printf("omWebBench escapes: %d passes over %d texts, %d over the 4k blocks\n",
+           count, (int)(sizeof(benchTexts) / sizeof(benchTexts[0])), count / 40);
+    for(int kind = 0; kind < kinds; kind++)
+    {
+        BenchNullStream s;
+        long long bytes = 0;
+        int passes = kind < 3 ? count : count / 40;
+        auto t0 = std::chrono::steady_clock::now();
+        for(int ix = 0; ix < passes; ix++)
+        {
+            OmXmlWriter w(&s);
+            w.beginElement("div");
+            if(kind == 3)
+                w.addContent(clean.c_str());
+            else if(kind == 4)
+                w.addContent(dirty.c_str());
+            else for(const char *text : benchTexts)
+            {
+                if(kind == 0)
+                    w.addAttribute("title", text);
+                else if(kind == 1)
+                    w.addContent(text);
+                else
+                    w.addAttributeUrlF("href", "/_control?page=p1&item=i%d&value=%s", ix & 31, text);
+            }
+            w.endElement();
+            bytes += w.getByteCount();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        printf("%-40s %8.1f MB/s %8.0f ns/pass\n", kindNames[kind], bytes / seconds / 1e6, seconds * 1e9 / passes);
+    }
+}
+
+/// every builtin control, with the odd values and names that take escaping or special cases.
+static void buildControlsPage(OmWebPages &p)
+{
+    p.beginPage("Controls");
+    p.addSlider(-50, 50, "s", benchProc, 3);
+    p.addTime("t", benchProc, 100);
+    p.addSelect("sel", benchProc, 2);
+    p.addSelectOption("one", 1);
+    p.addSelectOption("two & <2>", 2);
+    p.addSelect("empty", benchProc, 5);
+    p.addCheckbox("cb", "a", benchProc, 1);
+    p.addCheckboxX("b");
+    p.addCheckboxX("c");
+    p.addColor("col", benchProc, 0xabcdef);
+    p.addButton("b", benchProc);
+    p.addStaticHtml("<p>static</p>");
+    p.addPageLink("Bench");
+    p.addPageLinkMini("Bench", "mini");
+}
+
+class BenchStringStream : public OmIByteStream
+{
+public:
+    std::string s;
+    bool put(uint8_t ch) override { this->s += (char)ch; return true; }
+    bool putN(const uint8_t *data, size_t size) override { this->s.append((const char *)data, size); return true; }
+};
+
+/// the body of a page request, after checking any Content-Length against it.
+static std::string templatesGet(OmWebPages &p, const char *url, int &lengthsWrong)
+{
+    OmRequestInfo ri;
+    ri.keepAlive = true; // so there is a Content-Length
+    BenchStringStream s;
+    p.handleRequest(&s, url, &ri);
+    size_t headerEnd = s.s.find("\n\n");
+    std::string body = headerEnd == std::string::npos ? s.s : s.s.substr(headerEnd + 2);
+    size_t length = s.s.find("Content-Length: ");
+    if(length != std::string::npos && length < headerEnd && atoi(s.s.c_str() + length + 16) != (int)body.size())
+        lengthsWrong++;
+    return body;
+}
+
+/// the same site twice, one with the page cache and one without, must send the same pages.
+static int runTemplates()
+{
+    OmWebPages cached, direct;
+    for(OmWebPages *p : {&cached, &direct})
+    {
+        buildPages(*p);
+        buildControlsPage(*p);
+    }
+    cached.setPageCacheBudget(65536);
+    direct.setPageCacheBudget(0);
+
+    int values[] = {0, 1, 2, 3, 5, 7, -1, -50, 50, 1439, 0x8000, 0x8000 | 61, 0xffffff, 0x123, 1000000, -1000000};
+    const char *items[] = {"s", "t", "sel", "empty", "cb", "col"};
+    int compared = 0, mismatched = 0, lengthsWrong = 0;
+    for(int value : values)
+    {
+        for(const char *item : items)
+        {
+            cached.setValue("Controls", item, value);
+            direct.setValue("Controls", item, value);
+            cached.setValue("Bench", "Level <x>", value);
+            direct.setValue("Bench", "Level <x>", value);
+            for(const char *url : {"/Controls", "/Bench"})
+            {
+                std::string a = templatesGet(cached, url, lengthsWrong);
+                std::string b = templatesGet(direct, url, lengthsWrong);
+                compared++;
+                if(a != b)
+                {
+                    if(!mismatched)
+                        printf("%s differs at value %d of \"%s\":\n--- cached\n%s\n--- direct\n%s\n", url, value, item, a.c_str(), b.c_str());
+                    mismatched++;
+                }
+            }
+        }
+    }
+    printf("omWebBench templates: %d pages compared, %d different, %d wrong Content-Length, %u from templates\n",
+           compared, mismatched, lengthsWrong, cached.requestsCached);
+    return mismatched || lengthsWrong || !cached.requestsCached ? 1 : 0;
+}
+
+static uint32_t benchLittle(const std::string &s, size_t at, int size)
+{
+    uint32_t result = 0;
+    for(int ix = size - 1; ix >= 0; ix--)
+        result = (result << 8) | (uint8_t)s[at + ix];
+    return result;
+}
+
+/// decodes "_status.bin" as tools/omStatusBin.py does, and checks it against "_status.json",
+/// as omStatusBin.py --check does against a live server. Returns the problems found.
+static int statusBinCheck(OmWebPages &p, bool leftOutExpected)
+{
+    OmRequestInfo ri;
+    BenchStringStream s, json;
+    p.handleRequest(&json, "/_status.json", &ri);
+    int itemsExpected = 0;
+    for(size_t at = 0; (at = json.s.find("\"pageId\":", at)) != std::string::npos; at++)
+        itemsExpected++;
+    p.handleRequest(&s, "/_status.bin", &ri);
+    size_t headerEnd = s.s.find("\n\n");
+    std::string r = s.s.substr(headerEnd + 2);
+    int problems = 0;
+    auto check = [&](bool ok, const char *what)
+    {
+        if(!ok)
+        {
+            printf("    %s\n", what);
+            problems++;
+        }
+    };
+
+    check(r.compare(0, 4, "OmSB") == 0, "magic");
+    int scalarCount = (uint8_t)r[5];
+    size_t length = benchLittle(r, 6, 2);
+    check(length == r.size(), "length field isn't the record's length");
+    check(atoi(s.s.c_str() + s.s.find("Content-Length: ") + 16) == (int)r.size(), "Content-Length isn't the record's length");
+    size_t at = 8 + 2 * scalarCount;
+    uint32_t leftOut = 0;
+    for(int ix = 0; ix < scalarCount; ix++)
+    {
+        int tag = (uint8_t)r[8 + 2 * ix];
+        int size = (uint8_t)r[9 + 2 * ix];
+        if(tag == OMSB_LEFT_OUT)
+            leftOut = benchLittle(r, at, size);
+        at += size;
+    }
+    int items = 0;
+    while(at + 4 <= r.size())
+    {
+        int tag = (uint8_t)r[at];
+        int recordSize = (uint8_t)r[at + 1];
+        int count = benchLittle(r, at + 2, 2);
+        at += 4;
+        check(at + recordSize * count <= r.size(), "section runs past the end");
+        for(int ix = 0; ix < count && at + recordSize <= r.size(); ix++, at += recordSize)
+        {
+            if(tag == OMSB_ITEMS)
+            {
+                char expected[64];
+                sprintf(expected, "\"id\":\"i%d\",\"pageId\":\"p%d\",\"value\":%d,",
+                        (int)benchLittle(r, at + 2, 2), (int)benchLittle(r, at, 2), (int)benchLittle(r, at + 4, 4));
+                check(json.s.find(expected) != std::string::npos, "item isn't in _status.json with that value");
+                items++;
+            }
+            else if(tag == OMSB_EEPROM_INTS)
+                check((int)benchLittle(r, at + 2, 4) == OmEeprom.getInt(OmEeprom.getFieldName(benchLittle(r, at, 2))), "eeprom int value");
+        }
+    }
+    check(at == r.size(), "sections don't end at the length");
+    check((leftOut != 0) == leftOutExpected, "OMSB_LEFT_OUT");
+    check(items + (int)leftOut == itemsExpected, "items sent and left out don't add up");
+    printf("omWebBench status.bin: %d bytes, %d items, %d left out: %s\n", (int)r.size(), items, (int)leftOut, problems ? "WRONG" : "ok");
+    return problems;
+}
+
+static int runStatusBin()
+{
+    OmEeprom.addInt32("n");
+    OmEeprom.addInt16("m");
+    OmEeprom.begin();
+    OmEeprom.set("n", -7);
+    OmEeprom.set("m", 300);
+
+    OmWebPages small;
+    buildPages(small);
+    buildControlsPage(small);
+    small.setValue("Controls", "s", -42);
+    small.setValue("Controls", "col", 0xabcdef);
+    int problems = statusBinCheck(small, false);
+
+    // 8 bytes a record, so this is past 64k
+    OmWebPages big;
+    static char pageNames[9][8]; // beginPage keeps the pointer; and the same name would reopen the page
+    for(int pageIx = 0; pageIx < 9; pageIx++)
+    {
+        sprintf(pageNames[pageIx], "Big%d", pageIx);
+        big.beginPage(pageNames[pageIx]);
+        for(int ix = 0; ix < 1000; ix++)
+            big.addSlider(0, 100000, "x", benchProc, pageIx * 1000 + ix);
+    }
+    problems += statusBinCheck(big, true);
+    return problems ? 1 : 0;
+}
+
+/// the builtin files as written must be the ones tools/makeAssetsGz.py made OmWebPagesAssets.h from.
+static int assetCheck(OmWebPages &p, const char *url, uint32_t assetEtag, int assetSize)
+{
+    OmRequestInfo ri;
+    BenchStringStream s;
+    p.handleRequest(&s, url, &ri);
+    size_t headerEnd = s.s.find("\n\n");
+    size_t etagAt = s.s.find("ETag: \"");
+    uint32_t etag = etagAt < headerEnd ? (uint32_t)strtoul(s.s.c_str() + etagAt + 7, NULL, 16) : 0;
+    int size = headerEnd == std::string::npos ? 0 : (int)(s.s.size() - headerEnd - 2);
+    bool same = etag == assetEtag && size == assetSize;
+    printf("omWebBench assets: %s is %08x, %d bytes; OmWebPagesAssets.h has %08x, %d bytes: %s\n",
+           url, (unsigned int)etag, size, (unsigned int)assetEtag, assetSize, same ? "ok" : "STALE, rerun tools/makeAssetsGz.py");
+    return same ? 0 : 1;
+}
+
+static int runAssets()
+{
+    OmWebPages p;
+    int problems = assetCheck(p, "/_om.css?min=0", OM_ASSET_STYLE_ETAG, OM_ASSET_STYLE_SIZE);
+    problems += assetCheck(p, "/_om.js?min=0", OM_ASSET_SCRIPT_ETAG, OM_ASSET_SCRIPT_SIZE);
+    return problems ? 1 : 0;
+}
+
+/// a stream with only put(), so every putN() into it goes through the default, a byte at a time.
+class BenchBytewiseStream : public OmIByteStream
+{
+public:
+    uint32_t hash = 2166136261u;
+    size_t count = 0;
+    bool put(uint8_t ch) override { this->hash = (this->hash ^ ch) * 16777619u; this->count++; return true; }
+};
+
+/// and one that takes putN() whole; same hash, so the output can be compared.
+class BenchBulkStream : public BenchBytewiseStream
+{
+public:
+    bool putN(const uint8_t *data, size_t size) override
+    {
+        for(size_t ix = 0; ix < size; ix++)
+            this->hash = (this->hash ^ data[ix]) * 16777619u;
+        this->count += size;
+        return true;
+    }
+};
+
+/// the same pages and text into a stream that takes putN() and one that doesn't.
+static int runPutN(int count)
+{
+    OmWebPages cached, direct;
+    for(OmWebPages *p : {&cached, &direct})
+    {
+        buildPages(*p);
+        buildControlsPage(*p);
+    }
+    direct.setPageCacheBudget(0);
+    std::string clean;
+    while(clean.size() < 4096)
+        clean += "20:15:03.250 wifi: connected to garden, rssi -61, ip 192.168.1.23, 3 clients\n";
+
+    const int kinds = 3;
+    const char *kindNames[kinds] = {"page, rendered", "page, from template", "addContent 4k"};
+    int different = 0;
+    printf("omWebBench putN: %d passes, putN() and a byte at a time\n", count);
+    for(int kind = 0; kind < kinds; kind++)
+    {
+        double seconds[2];
+        uint32_t hashes[2];
+        for(int bulk = 0; bulk < 2; bulk++)
+        {
+            BenchBytewiseStream bytewise;
+            BenchBulkStream bulkStream;
+            BenchBytewiseStream &s = bulk ? bulkStream : bytewise;
+            OmRequestInfo ri;
+            auto t0 = std::chrono::steady_clock::now();
+            for(int ix = 0; ix < count; ix++)
+            {
+                if(kind == 2)
+                {
+                    OmXmlWriter w(&s);
+                    w.beginElement("pre");
+                    w.addContent(clean.c_str());
+                    w.endElement();
+                }
+                else
+                    (kind ? cached : direct).handleRequest(&s, "/Controls", &ri);
+            }
+            seconds[bulk] = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            hashes[bulk] = s.hash;
+            if(bulk)
+                printf("%-40s %8.1f MB/s putN %8.1f MB/s bytewise  x%.2f%s\n", kindNames[kind],
+                       s.count / seconds[1] / 1e6, s.count / seconds[0] / 1e6, seconds[0] / seconds[1],
+                       hashes[0] == hashes[1] ? "" : "  DIFFERENT OUTPUT");
+        }
+        if(hashes[0] != hashes[1])
+            different++;
+    }
+    return different ? 1 : 0;
+}
+
+static void serveForever(OmWebServer *s)
+{
+    while(serverRunning)
+    {
+        // the real loop() would do other things too; don't spin the cpu flat out.
+        if(!s->tick())
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+}
+
+class BenchConnection
+{
+public:
+    int fd = -1;
+    int port;
+    bool http10; // ask as HTTP/1.0, which can't read chunks, as "ab -k" does
+    std::string buffer;
+
+    BenchConnection(int port, bool http10) : port(port), http10(http10) {}
+    ~BenchConnection() { this->close(); }
+
+    void close()
+    {
+        if(this->fd >= 0)
+            ::close(this->fd);
+        this->fd = -1;
+        this->buffer.clear();
+    }
+
+    bool open()
+    {
+        this->fd = socket(AF_INET, SOCK_STREAM, 0);
+        int one = 1;
+        setsockopt(this->fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = htons(this->port);
+        if(connect(this->fd, (sockaddr *)&addr, sizeof(addr)) < 0)
+        {
+            this->close();
+            return false;
+        }
+        return true;
+    }
+
+    /// read more into the buffer; false at end of stream.
+    bool fill()
+    {
+        char chunk[4096];
+        ssize_t k = recv(this->fd, chunk, sizeof(chunk), 0);
+        if(k <= 0)
+            return false;
+        this->buffer.append(chunk, k);
+        return true;
+    }
+
+    /// just past the blank line that ends the header, or npos.
+    size_t findHeaderEnd()
+    {
+        size_t crlf = this->buffer.find("\r\n\r\n");
+        size_t lf = this->buffer.find("\n\n");
+        if(lf != std::string::npos && (crlf == std::string::npos || lf < crlf))
+            return lf + 2;
+        if(crlf != std::string::npos)
+            return crlf + 4;
+        return std::string::npos;
+    }
+
+    /// GET one url; returns the whole response size in bytes, or -1. A kept-alive
+    /// connection the server closed before any of the response came is tried
+    /// once more on a fresh one, as browsers do; retried says so.
+    long get(const char *url, bool keepAlive, bool &retried)
+    {
+        bool reused = this->fd >= 0;
+        bool answered = false;
+        long total = this->getOnce(url, keepAlive, answered);
+        retried = total < 0 && reused && !answered;
+        if(retried)
+        {
+            this->close();
+            total = this->getOnce(url, keepAlive, answered);
+        }
+        return total;
+    }
+
+    /// Reads until the end of the body by Content-Length, chunks, or close. A
+    /// response this client couldn't read, chunks to HTTP/1.0 or a body ended
+    /// by closing a connection said to be kept, is -1 too.
+    long getOnce(const char *url, bool keepAlive, bool &answered)
+    {
+        if(this->fd < 0 && !this->open())
+            return -1;
+
+        char request[512];
+        int n = snprintf(request, sizeof(request), "GET %s HTTP/1.%d\r\nHost: 127.0.0.1\r\nConnection: %s\r\n\r\n",
+                         url, this->http10 ? 0 : 1, keepAlive ? "keep-alive" : "close");
+        if(send(this->fd, request, n, MSG_NOSIGNAL) != n)
+            return -1;
+
+        // OmWebPages ends its header lines with a bare \n, so take either.
+        size_t headerEnd;
+        while((headerEnd = this->findHeaderEnd()) == std::string::npos)
+        {
+            if(!this->fill())
+                return -1;
+            answered = true;
+        }
+        std::string header = this->buffer.substr(0, headerEnd);
+        for(char &ch : header)
+            ch = tolower(ch);
+
+        long total;
+        size_t at;
+        if((at = header.find("content-length:")) != std::string::npos)
+        {
+            size_t length = strtoul(header.c_str() + at + 15, NULL, 10);
+            while(this->buffer.size() < headerEnd + length)
+                if(!this->fill())
+                    return -1;
+            total = headerEnd + length;
+            this->buffer.erase(0, total);
+        }
+        else if(header.find("transfer-encoding: chunked") != std::string::npos)
+        {
+            if(this->http10)
+                return -1;
+            size_t pos = headerEnd;
+            while(1)
+            {
+                size_t lineEnd;
+                while((lineEnd = this->buffer.find("\r\n", pos)) == std::string::npos)
+                    if(!this->fill())
+                        return -1;
+                size_t chunkSize = strtoul(this->buffer.c_str() + pos, NULL, 16);
+                size_t chunkEnd = lineEnd + 2 + chunkSize + 2;
+                while(this->buffer.size() < chunkEnd)
+                    if(!this->fill())
+                        return -1;
+                pos = chunkEnd;
+                if(chunkSize == 0)
+                    break;
+            }
+            total = pos;
+            this->buffer.erase(0, total);
+        }
+        else
+        {
+            if(header.find("connection: keep-alive") != std::string::npos)
+                return -1;
+            while(this->fill())
+                ;
+            total = this->buffer.size();
+            this->close();
+            return total;
+        }
+
+        if(!keepAlive || header.find("connection: close") != std::string::npos)
+            this->close();
+        return total;
+    }
+};
+
+typedef struct
+{
+    std::vector<double> latencies; // milliseconds
+    long long bytes = 0;
+    int failures = 0;
+    int retries = 0; // on a fresh connection, after the server closed a kept one
+} BenchResult;
+
+static void runClient(int port, const char *kind, int count, bool keepAlive, bool http10, int clientIndex, BenchResult *result)
+{
+    BenchConnection c(port, http10);
+    char url[200];
+    for(int ix = 0; ix < count; ix++)
+    {
+        if(!strcmp(kind, "page"))
+            snprintf(url, sizeof(url), "/Bench");
+        else if(!strcmp(kind, "control"))
+            snprintf(url, sizeof(url), "/_control?page=p1&item=i0&value=%d", (clientIndex * 7 + ix) % 100);
+        else
+            snprintf(url, sizeof(url), "/_status");
+
+        auto t0 = std::chrono::steady_clock::now();
+        bool retried;
+        long k = c.get(url, keepAlive, retried);
+        auto t1 = std::chrono::steady_clock::now();
+        if(retried)
+            result->retries++;
+        if(k < 0)
+        {
+            result->failures++;
+            c.close();
+            continue;
+        }
+        result->bytes += k;
+        result->latencies.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+    }
+}
+
+/// returns the requests that failed.
+static int runKind(int port, const char *kind, int clients, int count, bool keepAlive, bool http10)
+{
+    std::vector<BenchResult> results(clients);
+    std::vector<std::thread> threads;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for(int ix = 0; ix < clients; ix++)
+        threads.emplace_back(runClient, port, kind, count, keepAlive, http10, ix, &results[ix]);
+    for(auto &t : threads)
+        t.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    std::vector<double> all;
+    long long bytes = 0;
+    int failures = 0;
+    int retries = 0;
+    for(auto &r : results)
+    {
+        all.insert(all.end(), r.latencies.begin(), r.latencies.end());
+        bytes += r.bytes;
+        failures += r.failures;
+        retries += r.retries;
+    }
+    std::sort(all.begin(), all.end());
+    double p50 = all.size() ? all[all.size() / 2] : 0;
+    double p99 = all.size() ? all[std::min(all.size() - 1, all.size() * 99 / 100)] : 0;
+
+    printf("%-8s %7zu ok %4d fail %4d retried %9.0f req/s  p50 %7.3f ms  p99 %7.3f ms  %8.2f MB/s  %6lld B/req\n",
+           kind, all.size(), failures, retries, all.size() / seconds, p50, p99, bytes / seconds / 1e6,
+           all.size() ? bytes / (long long)all.size() : 0);
+    return failures;
+}
+
+int main(int argc, char *argv[])
+{
+    int clients = 4;
+    int count = 500;
+    int port = 8089;
+    bool keepAlive = false;
+    bool http10 = false;
+    bool dispatch = false;
+    bool escapes = false;
+    bool putN = false;
+    bool templates = false;
+    bool statusBin = false;
+    bool assets = false;
+    int opt;
+    while((opt = getopt(argc, argv, "c:n:p:k0dxwtba")) != -1)
+    {
+        switch(opt)
+        {
+            case 'c': clients = atoi(optarg); break;
+            case 'n': count = atoi(optarg); break;
+            case 'p': port = atoi(optarg); break;
+            case 'k': keepAlive = true; break;
+            case '0': http10 = true; break;
+            case 'd': dispatch = true; break;
+            case 'x': escapes = true; break;
+            case 'w': putN = true; break;
+            case 't': templates = true; break;
+            case 'b': statusBin = true; break;
+            case 'a': assets = true; break;
+            default:
+                fprintf(stderr, "usage: %s [-c clients] [-n requestsPerClient] [-p port] [-k] [-0] [-d] [-x] [-w] [-t] [-b] [-a]\n", argv[0]);
+                return 1;
+        }
+    }
+
+    if(dispatch)
+    {
+        runDispatch(count * 100);
+        return 0;
+    }
+    if(escapes)
+    {
+        runEscapes(count * 1000);
+        return 0;
+    }
+    if(putN)
+        return runPutN(count * 10);
+    if(templates)
+        return runTemplates();
+    if(statusBin)
+        return runStatusBin();
+    if(assets)
+        return runAssets();
+
+    OmWebPages p;
+    buildPages(p);
+
+    OmWebServer s(port);
+    s.setVerbose(0);
+    s.addWifi("loopback", "");
+    if(keepAlive)
+        s.setKeepAlive(2000, 1000000);
+    s.setHandler(p);
+
+    // tick until the (pretend) wifi joins and the server is listening
+    while(!s.isWifiConnected())
+        s.tick();
+    s.tick();
+
+    std::thread server(serveForever, &s);
+
+    printf("omWebBench: %d clients x %d requests, %s%s, port %d\n", clients, count, keepAlive ? "keep-alive" : "close",
+           http10 ? ", HTTP/1.0" : "", port);
+    int failures = runKind(port, "page", clients, count, keepAlive, http10);
+    failures += runKind(port, "control", clients, count, keepAlive, http10);
+    failures += runKind(port, "status", clients, count, keepAlive, http10);
+
+    serverRunning = false;
+    server.join();
+    return failures ? 1 : 0; // the numbers don't count if requests failed
+}